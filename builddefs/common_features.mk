@@ -919,6 +919,15 @@ ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
 
     SRC += ws2812_$(strip $(WS2812_DRIVER)).c
 
+    # rgblight and RGB Matrix on the same chain can render into one shared frame buffer
+    ifeq ($(strip $(WS2812_SHARED_FRAMEBUFFER)), yes)
+        ifneq ($(strip $(RGBLIGHT_ENABLE))$(strip $(RGBLIGHT_DRIVER)) $(strip $(RGB_MATRIX_ENABLE))$(strip $(RGB_MATRIX_DRIVER)), yesws2812 yesws2812)
+            $(call CATASTROPHIC_ERROR,Invalid WS2812_SHARED_FRAMEBUFFER,WS2812_SHARED_FRAMEBUFFER requires both RGBLight and RGB Matrix to use the ws2812 driver)
+        endif
+        OPT_DEFS += -DWS2812_SHARED_FRAMEBUFFER
+        SRC += $(QUANTUM_DIR)/ws2812_framebuffer.c
+    endif
+
     ifeq ($(strip $(PLATFORM)), CHIBIOS)
         ifeq ($(strip $(WS2812_DRIVER)), pwm)
             OPT_DEFS += -DSTM32_DMA_REQUIRED=TRUE
@@ -20,6 +20,7 @@ HARDWARE_OPTION_NAMES = \
   RGBLIGHT_DRIVER \
   RGB_MATRIX_ENABLE \
   RGB_MATRIX_DRIVER \
+  WS2812_SHARED_FRAMEBUFFER \
   CIE1931_CURVE \
   MIDI_ENABLE \
   BLUETOOTH_ENABLE \
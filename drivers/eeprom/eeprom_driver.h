@@ -20,3 +20,10 @@
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_BACK)
+void eeprom_driver_flush(void);
+#endif
+#if defined(EEPROM_WEAR_LEVELING) && (defined(WEAR_LEVELING_WRITE_BACK) || defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION))
+void eeprom_driver_task(void);
+#endif
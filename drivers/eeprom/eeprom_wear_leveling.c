@@ -6,6 +6,16 @@
 #include "eeprom_driver.h"
 #include "wear_leveling.h"
 
+#ifdef WEAR_LEVELING_WRITE_BACK
+#    include "timer.h"
+
+#    ifndef WEAR_LEVELING_WRITE_BACK_IDLE_TIME
+#        define WEAR_LEVELING_WRITE_BACK_IDLE_TIME 1000
+#    endif
+
+static uint32_t last_write_time = 0;
+#endif // WEAR_LEVELING_WRITE_BACK
+
 void eeprom_driver_init(void) {
     wear_leveling_init();
 }
@@ -20,4 +30,27 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
     wear_leveling_write((uint32_t)addr, buf, len);
+#ifdef WEAR_LEVELING_WRITE_BACK
+    last_write_time = timer_read32();
+#endif // WEAR_LEVELING_WRITE_BACK
+}
+
+#ifdef WEAR_LEVELING_WRITE_BACK
+void eeprom_driver_flush(void) {
+    wear_leveling_flush();
+}
+#endif // WEAR_LEVELING_WRITE_BACK
+
+#if defined(WEAR_LEVELING_WRITE_BACK) || defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+void eeprom_driver_task(void) {
+#    ifdef WEAR_LEVELING_WRITE_BACK
+    // Only flush once writes have settled, so that bursts of updates are coalesced into a single set of log entries
+    if (wear_leveling_has_pending_writes() && timer_elapsed32(last_write_time) >= (WEAR_LEVELING_WRITE_BACK_IDLE_TIME)) {
+        wear_leveling_flush();
+    }
+#    endif // WEAR_LEVELING_WRITE_BACK
+#    ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    wear_leveling_task();
+#    endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 }
+#endif
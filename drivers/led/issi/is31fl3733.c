@@ -18,6 +18,7 @@
  */
 
 #include "is31fl3733.h"
+#include "is31fl_pwm_chunks.h"
 #include <string.h>
 #include "i2c_master.h"
 #include "wait.h"
@@ -71,8 +72,8 @@ uint8_t g_twi_transfer_buffer[20];
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in is31fl3733_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[IS31FL3733_DRIVER_COUNT][IS31FL3733_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[IS31FL3733_DRIVER_COUNT] = {false};
+uint8_t  g_pwm_buffer[IS31FL3733_DRIVER_COUNT][IS31FL3733_PWM_REGISTER_COUNT];
+uint32_t g_pwm_buffer_dirty_chunks[IS31FL3733_DRIVER_COUNT] = {0};
 
 uint8_t g_led_control_registers[IS31FL3733_DRIVER_COUNT][IS31FL3733_LED_CONTROL_REGISTER_COUNT] = {0};
 bool    g_led_control_registers_update_required[IS31FL3733_DRIVER_COUNT]                        = {false};
@@ -125,6 +126,36 @@ bool is31fl3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     return true;
 }
 
+static void is31fl3733_select_pwm_page(uint8_t addr, uint8_t command) {
+    // unlock the command register and select PG1
+    is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
+    is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND, command);
+}
+
+static bool is31fl3733_write_pwm_range(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t length) {
+#if IS31FL3733_I2C_PERSISTENCE > 0
+    for (uint8_t i = 0; i < IS31FL3733_I2C_PERSISTENCE; i++) {
+        if (i2c_writeReg(addr << 1, reg, data, length, IS31FL3733_I2C_TIMEOUT) != 0) {
+            return false;
+        }
+    }
+#else
+    if (i2c_writeReg(addr << 1, reg, data, length, IS31FL3733_I2C_TIMEOUT) != 0) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+static const is31fl_pwm_chunks_config_t is31fl3733_pwm_chunks = {
+    .register_count = IS31FL3733_PWM_REGISTER_COUNT,
+    .chunk_size     = 16,
+    .page_chunk     = IS31FL_PWM_CHUNK_COUNT(IS31FL3733_PWM_REGISTER_COUNT, 16),
+    .page_commands  = {IS31FL3733_COMMAND_PWM},
+    .select_page    = is31fl3733_select_pwm_page,
+    .write          = is31fl3733_write_pwm_range,
+};
+
 void is31fl3733_init_drivers(void) {
     i2c_init();
 
@@ -209,10 +240,12 @@ void is31fl3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         if (g_pwm_buffer[led.driver][led.r] == red && g_pwm_buffer[led.driver][led.g] == green && g_pwm_buffer[led.driver][led.b] == blue) {
             return;
         }
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        g_pwm_buffer[led.driver][led.r] = red;
+        g_pwm_buffer[led.driver][led.g] = green;
+        g_pwm_buffer[led.driver][led.b] = blue;
+        is31fl_pwm_chunks_mark(&g_pwm_buffer_dirty_chunks[led.driver], &is31fl3733_pwm_chunks, led.r);
+        is31fl_pwm_chunks_mark(&g_pwm_buffer_dirty_chunks[led.driver], &is31fl3733_pwm_chunks, led.g);
+        is31fl_pwm_chunks_mark(&g_pwm_buffer_dirty_chunks[led.driver], &is31fl3733_pwm_chunks, led.b);
     }
 }
 
@@ -253,17 +286,13 @@ void is31fl3733_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void is31fl3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        // Firstly we need to unlock the command register and select PG1.
-        is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
-        is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND, IS31FL3733_COMMAND_PWM);
-
+    // Chunks that fail to send stay dirty and are retried on the next update
+    if (g_pwm_buffer_dirty_chunks[index]) {
         // If any of the transactions fail we risk writing dirty PG0,
         // refresh page 0 just in case.
-        if (!is31fl3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        if (!is31fl_pwm_chunks_write(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty_chunks[index], &is31fl3733_pwm_chunks)) {
             g_led_control_registers_update_required[index] = true;
         }
-        g_pwm_buffer_update_required[index] = false;
     }
 }
 
@@ -18,12 +18,18 @@
  */
 
 #include "is31fl3741.h"
+#include "is31fl_pwm_chunks.h"
 #include <string.h>
 #include "i2c_master.h"
 #include "wait.h"
 
 #define IS31FL3741_PWM_REGISTER_COUNT 351
 
+// The PWM registers are tracked in 18 byte chunks. Chunks 0-9 are on PG0 and
+// 10-19 on PG1, with the final chunk only 9 bytes long.
+#define IS31FL3741_PWM_CHUNK_SIZE 18
+#define IS31FL3741_PWM_CHUNKS_ALL IS31FL_PWM_CHUNKS_ALL(IS31FL_PWM_CHUNK_COUNT(IS31FL3741_PWM_REGISTER_COUNT, IS31FL3741_PWM_CHUNK_SIZE))
+
 #ifndef IS31FL3741_I2C_TIMEOUT
 #    define IS31FL3741_I2C_TIMEOUT 100
 #endif
@@ -61,13 +67,108 @@ uint8_t g_twi_transfer_buffer[20] = {0xFF};
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in is31fl3741_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[IS31FL3741_DRIVER_COUNT][IS31FL3741_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[IS31FL3741_DRIVER_COUNT]        = {false};
-bool    g_scaling_registers_update_required[IS31FL3741_DRIVER_COUNT] = {false};
+uint8_t  g_pwm_buffer[IS31FL3741_DRIVER_COUNT][IS31FL3741_PWM_REGISTER_COUNT];
+uint32_t g_pwm_buffer_dirty_chunks[IS31FL3741_DRIVER_COUNT]          = {0};
+bool     g_scaling_registers_update_required[IS31FL3741_DRIVER_COUNT] = {false};
 
 uint8_t g_scaling_registers[IS31FL3741_DRIVER_COUNT][IS31FL3741_PWM_REGISTER_COUNT];
 
+#ifdef I2C_ASYNC_ENABLE
+#    define IS31FL3741_PWM_CHUNK_COUNT IS31FL_PWM_CHUNK_COUNT(IS31FL3741_PWM_REGISTER_COUNT, IS31FL3741_PWM_CHUNK_SIZE)
+
+// With I2C_ASYNC_ENABLE each dirty chunk is queued as its own low priority
+// transaction, so a high priority transfer waits for one chunk at most. The
+// frames hold a copy of the chunk, as the PWM buffer keeps changing meanwhile.
+// The transactions of a driver are its chunks, then unlocking and selecting
+// PG0, then the same for PG1.
+#    define IS31FL3741_QUEUED_UNLOCK(page) (IS31FL3741_PWM_CHUNK_COUNT + 2 * (page))
+#    define IS31FL3741_QUEUED_SELECT_PAGE(page) (IS31FL3741_PWM_CHUNK_COUNT + 2 * (page) + 1)
+#    define IS31FL3741_QUEUED_COUNT (IS31FL3741_PWM_CHUNK_COUNT + 4)
+
+static i2c_async_transaction_t is31fl3741_queued[IS31FL3741_DRIVER_COUNT][IS31FL3741_QUEUED_COUNT];
+static uint8_t                 is31fl3741_queued_frames[IS31FL3741_DRIVER_COUNT][IS31FL3741_PWM_CHUNK_COUNT][1 + IS31FL3741_PWM_CHUNK_SIZE];
+
+static const uint8_t is31fl3741_unlock_frame[]         = {IS31FL3741_REG_COMMAND_WRITE_LOCK, IS31FL3741_COMMAND_WRITE_LOCK_MAGIC};
+static const uint8_t is31fl3741_select_page_frame[][2] = {{IS31FL3741_REG_COMMAND, IS31FL3741_COMMAND_PWM_0}, {IS31FL3741_REG_COMMAND, IS31FL3741_COMMAND_PWM_1}};
+
+// Blocking writes wait for the queued ones, as they may select another page
+static void is31fl3741_wait_queued(void) {
+    for (uint8_t index = 0; index < IS31FL3741_DRIVER_COUNT; index++) {
+        for (uint8_t i = 0; i < IS31FL3741_QUEUED_COUNT; i++) {
+            i2c_async_wait(&is31fl3741_queued[index][i]);
+        }
+    }
+}
+
+static void is31fl3741_queue(uint8_t index, uint8_t slot, uint8_t addr, const uint8_t *frame, uint16_t length) {
+    is31fl3741_queued[index][slot] = (i2c_async_transaction_t){
+        .address   = addr << 1,
+        .tx_data   = frame,
+        .tx_length = length,
+        .timeout   = IS31FL3741_I2C_TIMEOUT,
+        .priority  = I2C_ASYNC_PRIORITY_LOW,
+    };
+    i2c_async_submit(&is31fl3741_queued[index][slot]);
+}
+
+static void is31fl3741_queue_pwm_chunks(uint8_t addr, uint8_t index) {
+    // The previous update is still being sent, the chunks stay dirty until the next one
+    for (uint8_t i = 0; i < IS31FL3741_QUEUED_COUNT; i++) {
+        if (i2c_async_is_busy(&is31fl3741_queued[index][i])) {
+            return;
+        }
+    }
+
+    // Resend the chunks which failed last time
+    for (uint8_t chunk = 0; chunk < IS31FL3741_PWM_CHUNK_COUNT; chunk++) {
+        if (is31fl3741_queued[index][chunk].status != I2C_STATUS_SUCCESS) {
+            is31fl3741_queued[index][chunk].status = I2C_STATUS_SUCCESS;
+            g_pwm_buffer_dirty_chunks[index] |= 1UL << chunk;
+        }
+    }
+
+    // If selecting a page failed, the chunks that followed were written to the
+    // page still selected, so every chunk of both pages has to be resent
+    for (uint8_t page = 0; page < 2; page++) {
+        i2c_async_transaction_t *unlock      = &is31fl3741_queued[index][IS31FL3741_QUEUED_UNLOCK(page)];
+        i2c_async_transaction_t *select_page = &is31fl3741_queued[index][IS31FL3741_QUEUED_SELECT_PAGE(page)];
+        if (unlock->status != I2C_STATUS_SUCCESS || select_page->status != I2C_STATUS_SUCCESS) {
+            unlock->status                   = I2C_STATUS_SUCCESS;
+            select_page->status              = I2C_STATUS_SUCCESS;
+            g_pwm_buffer_dirty_chunks[index] = IS31FL3741_PWM_CHUNKS_ALL;
+        }
+    }
+
+    uint8_t page = UINT8_MAX;
+    for (uint8_t chunk = 0; chunk < IS31FL3741_PWM_CHUNK_COUNT; chunk++) {
+        if (!(g_pwm_buffer_dirty_chunks[index] & (1UL << chunk))) {
+            continue;
+        }
+
+        uint16_t start      = chunk * IS31FL3741_PWM_CHUNK_SIZE;
+        uint8_t  chunk_page = start >= 180;
+        uint8_t  length     = MIN(IS31FL3741_PWM_CHUNK_SIZE, IS31FL3741_PWM_REGISTER_COUNT - start);
+        uint8_t *frame      = is31fl3741_queued_frames[index][chunk];
+
+        if (page != chunk_page) {
+            is31fl3741_queue(index, IS31FL3741_QUEUED_UNLOCK(chunk_page), addr, is31fl3741_unlock_frame, sizeof(is31fl3741_unlock_frame));
+            is31fl3741_queue(index, IS31FL3741_QUEUED_SELECT_PAGE(chunk_page), addr, is31fl3741_select_page_frame[chunk_page], sizeof(is31fl3741_select_page_frame[chunk_page]));
+            page = chunk_page;
+        }
+
+        frame[0] = start % 180;
+        memcpy(&frame[1], &g_pwm_buffer[index][start], length);
+        is31fl3741_queue(index, chunk, addr, frame, 1 + length);
+    }
+
+    g_pwm_buffer_dirty_chunks[index] = 0;
+}
+#endif
+
 void is31fl3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
+#ifdef I2C_ASYNC_ENABLE
+    is31fl3741_wait_queued();
+#endif
     g_twi_transfer_buffer[0] = reg;
     g_twi_transfer_buffer[1] = data;
 
@@ -80,51 +181,45 @@ void is31fl3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-bool is31fl3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
-    // Assume PG0 is already selected
-
-    for (int i = 0; i < 342; i += 18) {
-        if (i == 180) {
-            // unlock the command register and select PG1
-            is31fl3741_write_register(addr, IS31FL3741_REG_COMMAND_WRITE_LOCK, IS31FL3741_COMMAND_WRITE_LOCK_MAGIC);
-            is31fl3741_write_register(addr, IS31FL3741_REG_COMMAND, IS31FL3741_COMMAND_PWM_1);
-        }
-
-        g_twi_transfer_buffer[0] = i % 180;
-        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, 18);
-
-#if IS31FL3741_I2C_PERSISTENCE > 0
-        for (uint8_t i = 0; i < IS31FL3741_I2C_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, IS31FL3741_I2C_TIMEOUT) != 0) {
-                return false;
-            }
-        }
-#else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, IS31FL3741_I2C_TIMEOUT) != 0) {
-            return false;
-        }
-#endif
-    }
-
-    // transfer the left cause the total number is 351
-    g_twi_transfer_buffer[0] = 162;
-    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + 342, 9);
+static void is31fl3741_select_pwm_page(uint8_t addr, uint8_t command) {
+    // unlock the command register and select PG0 or PG1
+    is31fl3741_write_register(addr, IS31FL3741_REG_COMMAND_WRITE_LOCK, IS31FL3741_COMMAND_WRITE_LOCK_MAGIC);
+    is31fl3741_write_register(addr, IS31FL3741_REG_COMMAND, command);
+}
 
+static bool is31fl3741_write_pwm_range(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t length) {
 #if IS31FL3741_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3741_I2C_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, IS31FL3741_I2C_TIMEOUT) != 0) {
+        if (i2c_writeReg(addr << 1, reg, data, length, IS31FL3741_I2C_TIMEOUT) != 0) {
             return false;
         }
     }
 #else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, IS31FL3741_I2C_TIMEOUT) != 0) {
+    if (i2c_writeReg(addr << 1, reg, data, length, IS31FL3741_I2C_TIMEOUT) != 0) {
         return false;
     }
 #endif
-
     return true;
 }
 
+static const is31fl_pwm_chunks_config_t is31fl3741_pwm_chunks = {
+    .register_count = IS31FL3741_PWM_REGISTER_COUNT,
+    .chunk_size     = IS31FL3741_PWM_CHUNK_SIZE,
+    .page_chunk     = 180 / IS31FL3741_PWM_CHUNK_SIZE,
+    .page_commands  = {IS31FL3741_COMMAND_PWM_0, IS31FL3741_COMMAND_PWM_1},
+    .select_page    = is31fl3741_select_pwm_page,
+    .write          = is31fl3741_write_pwm_range,
+};
+
+bool is31fl3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    uint32_t chunks = IS31FL3741_PWM_CHUNKS_ALL;
+    return is31fl_pwm_chunks_write(addr, pwm_buffer, &chunks, &is31fl3741_pwm_chunks);
+}
+
+static inline void is31fl3741_mark_pwm_dirty(uint8_t driver, uint16_t reg) {
+    is31fl_pwm_chunks_mark(&g_pwm_buffer_dirty_chunks[driver], &is31fl3741_pwm_chunks, reg);
+}
+
 void is31fl3741_init_drivers(void) {
     i2c_init();
 
@@ -139,6 +234,11 @@ void is31fl3741_init_drivers(void) {
 #    endif
 #endif
 
+    // Send the whole PWM page on the first update, whatever the registers held
+    for (int i = 0; i < IS31FL3741_DRIVER_COUNT; i++) {
+        g_pwm_buffer_dirty_chunks[i] = IS31FL3741_PWM_CHUNKS_ALL;
+    }
+
     for (int i = 0; i < IS31FL3741_LED_COUNT; i++) {
         is31fl3741_set_led_control_register(i, true, true, true);
     }
@@ -192,10 +292,12 @@ void is31fl3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         if (g_pwm_buffer[led.driver][led.r] == red && g_pwm_buffer[led.driver][led.g] == green && g_pwm_buffer[led.driver][led.b] == blue) {
             return;
         }
-        g_pwm_buffer_update_required[led.driver] = true;
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
+        g_pwm_buffer[led.driver][led.r] = red;
+        g_pwm_buffer[led.driver][led.g] = green;
+        g_pwm_buffer[led.driver][led.b] = blue;
+        is31fl3741_mark_pwm_dirty(led.driver, led.r);
+        is31fl3741_mark_pwm_dirty(led.driver, led.g);
+        is31fl3741_mark_pwm_dirty(led.driver, led.b);
     }
 }
 
@@ -231,15 +333,14 @@ void is31fl3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void is31fl3741_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        // unlock the command register and select PG2
-        is31fl3741_write_register(addr, IS31FL3741_REG_COMMAND_WRITE_LOCK, IS31FL3741_COMMAND_WRITE_LOCK_MAGIC);
-        is31fl3741_write_register(addr, IS31FL3741_REG_COMMAND, IS31FL3741_COMMAND_PWM_0);
-
-        is31fl3741_write_pwm_buffer(addr, g_pwm_buffer[index]);
+    // Chunks that fail to send stay dirty and are retried on the next update
+#ifdef I2C_ASYNC_ENABLE
+    is31fl3741_queue_pwm_chunks(addr, index);
+#else
+    if (g_pwm_buffer_dirty_chunks[index]) {
+        is31fl_pwm_chunks_write(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty_chunks[index], &is31fl3741_pwm_chunks);
     }
-
-    g_pwm_buffer_update_required[index] = false;
+#endif
 }
 
 void is31fl3741_set_pwm_buffer(const is31fl3741_led_t *pled, uint8_t red, uint8_t green, uint8_t blue) {
@@ -247,7 +348,9 @@ void is31fl3741_set_pwm_buffer(const is31fl3741_led_t *pled, uint8_t red, uint8_
     g_pwm_buffer[pled->driver][pled->g] = green;
     g_pwm_buffer[pled->driver][pled->b] = blue;
 
-    g_pwm_buffer_update_required[pled->driver] = true;
+    is31fl3741_mark_pwm_dirty(pled->driver, pled->r);
+    is31fl3741_mark_pwm_dirty(pled->driver, pled->g);
+    is31fl3741_mark_pwm_dirty(pled->driver, pled->b);
 }
 
 void is31fl3741_update_led_control_registers(uint8_t addr, uint8_t index) {
@@ -0,0 +1,82 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Tracks which chunks of an ISSI PWM register buffer changed since they were
+ * last sent, so a flush only sends those. Adjacent dirty chunks are coalesced
+ * into a single write. A buffer may have up to 32 chunks, and its registers
+ * may be split over two pages.
+ */
+
+#define IS31FL_PWM_CHUNK_COUNT(register_count, chunk_size) (((register_count) + (chunk_size)-1) / (chunk_size))
+#define IS31FL_PWM_CHUNKS_ALL(chunk_count) ((uint32_t)((1ULL << (chunk_count)) - 1))
+
+typedef struct {
+    uint16_t register_count;
+    uint8_t  chunk_size;
+    // first chunk of the second page, or the chunk count if there is only one page
+    uint8_t page_chunk;
+    // command register values selecting the first and the second page
+    uint8_t page_commands[2];
+    // unlocks the command register and writes one of page_commands to it, may be NULL
+    void (*select_page)(uint8_t addr, uint8_t command);
+    // writes length registers, starting at offset within the selected page
+    bool (*write)(uint8_t addr, uint8_t offset, const uint8_t *data, uint16_t length);
+} is31fl_pwm_chunks_config_t;
+
+static inline void is31fl_pwm_chunks_mark(uint32_t *chunks, const is31fl_pwm_chunks_config_t *config, uint16_t reg) {
+    *chunks |= 1UL << (reg / config->chunk_size);
+}
+
+/**
+ * @brief Sends each run of dirty chunks as a single write, selecting the
+ * page of each run as needed. A run never crosses into the second page.
+ *
+ * @param chunks bitmap of dirty chunks, the chunks sent are cleared
+ * @return false if a write failed; that chunk and the following ones stay dirty
+ */
+static inline bool is31fl_pwm_chunks_write(uint8_t addr, const uint8_t *pwm_buffer, uint32_t *chunks, const is31fl_pwm_chunks_config_t *config) {
+    uint8_t chunk_count = IS31FL_PWM_CHUNK_COUNT(config->register_count, config->chunk_size);
+    uint8_t page        = UINT8_MAX;
+    uint8_t chunk       = 0;
+
+    while (chunk < chunk_count) {
+        if (!(*chunks & (1UL << chunk))) {
+            chunk++;
+            continue;
+        }
+
+        uint8_t first      = chunk;
+        uint8_t first_page = first >= config->page_chunk;
+        uint8_t page_end   = first_page ? chunk_count : config->page_chunk;
+        while (chunk < page_end && (*chunks & (1UL << chunk))) {
+            chunk++;
+        }
+
+        if (page != first_page) {
+            if (config->select_page) {
+                config->select_page(addr, config->page_commands[first_page]);
+            }
+            page = first_page;
+        }
+
+        uint16_t start = first * config->chunk_size;
+        uint16_t end   = chunk * config->chunk_size;
+        if (end > config->register_count) {
+            end = config->register_count;
+        }
+        uint16_t page_start = first_page ? config->page_chunk * config->chunk_size : 0;
+
+        if (!config->write(addr, start - page_start, pwm_buffer + start, end - start)) {
+            return false;
+        }
+
+        *chunks &= ~(((1UL << (chunk - first)) - 1) << first);
+    }
+
+    return true;
+}
@@ -19,6 +19,7 @@
  */
 
 #include "is31flcommon.h"
+#include "is31fl_pwm_chunks.h"
 #include "i2c_master.h"
 #include "wait.h"
 #include <string.h>
@@ -36,8 +37,8 @@ uint8_t g_twi_transfer_buffer[20];
 
 // These buffers match the PWM & scaling registers.
 // Storing them like this is optimal for I2C transfers to the registers.
-uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+uint8_t  g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
+uint32_t g_pwm_buffer_dirty_chunks[DRIVER_COUNT] = {0};
 
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
@@ -89,6 +90,30 @@ void IS31FL_unlock_register(uint8_t addr, uint8_t page) {
     IS31FL_write_single_register(addr, ISSI_COMMANDREGISTER, page);
 }
 
+static bool IS31FL_write_pwm_range(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t length) {
+#if ISSI_PERSISTENCE > 0
+    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+        if (i2c_writeReg(addr << 1, ISSI_PWM_REG_1ST + reg, data, length, ISSI_TIMEOUT) != 0) {
+            return false;
+        }
+    }
+#else
+    if (i2c_writeReg(addr << 1, ISSI_PWM_REG_1ST + reg, data, length, ISSI_TIMEOUT) != 0) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+static const is31fl_pwm_chunks_config_t IS31FL_pwm_chunks = {
+    .register_count = ISSI_MAX_LEDS,
+    .chunk_size     = ISSI_PWM_TRF_SIZE,
+    .page_chunk     = IS31FL_PWM_CHUNK_COUNT(ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE),
+    .page_commands  = {ISSI_PAGE_PWM},
+    .select_page    = IS31FL_unlock_register,
+    .write          = IS31FL_write_pwm_range,
+};
+
 void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
     // Setup phase, need to take out of software shutdown and configure
     // ISSI_SSR_x is passed to allow Master / Slave setting where applicable
@@ -121,13 +146,10 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
 }
 
 void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        // Queue up the correct page
-        IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
-        // Update flags that pwm_buffer has been updated
-        g_pwm_buffer_update_required[index] = false;
+    // Only the chunks that changed are sent, the ones that fail stay dirty
+    // and are retried on the next update
+    if (g_pwm_buffer_dirty_chunks[index]) {
+        is31fl_pwm_chunks_write(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty_chunks[index], &IS31FL_pwm_chunks);
     }
 }
 
@@ -229,10 +251,15 @@ void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         is31_led led;
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        if (g_pwm_buffer[led.driver][led.r] == red && g_pwm_buffer[led.driver][led.g] == green && g_pwm_buffer[led.driver][led.b] == blue) {
+            return;
+        }
+        g_pwm_buffer[led.driver][led.r] = red;
+        g_pwm_buffer[led.driver][led.g] = green;
+        g_pwm_buffer[led.driver][led.b] = blue;
+        is31fl_pwm_chunks_mark(&g_pwm_buffer_dirty_chunks[led.driver], &IS31FL_pwm_chunks, led.r);
+        is31fl_pwm_chunks_mark(&g_pwm_buffer_dirty_chunks[led.driver], &IS31FL_pwm_chunks, led.g);
+        is31fl_pwm_chunks_mark(&g_pwm_buffer_dirty_chunks[led.driver], &IS31FL_pwm_chunks, led.b);
     }
 }
 
@@ -317,8 +344,11 @@ void IS31FL_simple_set_brightness(int index, uint8_t value) {
         is31_led led;
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
+        if (g_pwm_buffer[led.driver][led.v] == value) {
+            return;
+        }
         g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        is31fl_pwm_chunks_mark(&g_pwm_buffer_dirty_chunks[led.driver], &IS31FL_pwm_chunks, led.v);
     }
 }
 
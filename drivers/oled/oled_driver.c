@@ -30,6 +30,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <string.h>
 #include "progmem.h"
 #include "wait.h"
+#include "util.h"
 
 // Used commands from spec sheet: https://cdn-shop.adafruit.com/datasheets/SSD1306.pdf
 // for SH1106: https://www.velleman.eu/downloads/29/infosheets/sh1106_datasheet.pdf
@@ -165,6 +166,11 @@ uint32_t oled_scroll_timeout;
 #if OLED_UPDATE_INTERVAL > 0
 uint16_t oled_update_timeout;
 #endif
+#ifdef OLED_DIFF_RENDER
+// Copy of what has last been sent to the display, used to only send the bytes which actually changed
+uint8_t         oled_shadow_buffer[OLED_MATRIX_SIZE];
+OLED_BLOCK_TYPE oled_shadow_stale = 0; // blocks whose display memory contents are unknown, and must be sent in full
+#endif
 
 #if defined(OLED_TRANSPORT_SPI)
 #    ifndef OLED_DC_PIN
@@ -185,6 +191,78 @@ uint16_t oled_update_timeout;
 #    endif
 #endif
 
+#if defined(OLED_TRANSPORT_I2C) && defined(I2C_ASYNC_ENABLE)
+#    define OLED_QUEUED_RENDER
+#    ifndef OLED_QUEUE_SIZE
+#        define OLED_QUEUE_SIZE 4
+#    endif
+
+// Rendering queues its transfers at low priority instead of waiting for them. Each slot holds a copy of what it sends,
+// as the buffer keeps changing before the transfer happens.
+static i2c_async_transaction_t oled_queue[OLED_QUEUE_SIZE];
+static uint8_t                 oled_queue_frames[OLED_QUEUE_SIZE][1 + MAX(OLED_BLOCK_SIZE, OLED_DISPLAY_WIDTH)];
+static uint8_t                 oled_queue_next = 0;
+
+static void oled_queue_failed(void);
+
+// Checks the transfers of earlier renders, returns false if some are still queued
+static bool oled_queue_idle(void) {
+    bool idle = true;
+    for (uint8_t i = 0; i < OLED_QUEUE_SIZE; i++) {
+        if (i2c_async_is_busy(&oled_queue[i])) {
+            idle = false;
+        } else if (oled_queue[i].status != I2C_STATUS_SUCCESS) {
+            oled_queue[i].status = I2C_STATUS_SUCCESS;
+            oled_queue_failed();
+        }
+    }
+    return idle;
+}
+
+static void oled_queue_wait(void) {
+    for (uint8_t i = 0; i < OLED_QUEUE_SIZE; i++) {
+        i2c_async_wait(&oled_queue[i]);
+    }
+}
+
+// Copies the transfer to the next slot, waiting for that slot if it is still queued
+static bool oled_queue_send(uint8_t control, const uint8_t *data, uint16_t size) {
+    i2c_async_transaction_t *transaction = &oled_queue[oled_queue_next];
+    uint8_t *                frame       = oled_queue_frames[oled_queue_next];
+    oled_queue_next                      = (oled_queue_next + 1) % OLED_QUEUE_SIZE;
+
+    if (i2c_async_wait(transaction) != I2C_STATUS_SUCCESS) {
+        oled_queue_failed();
+    }
+
+    frame[0] = control;
+    memcpy(&frame[1], data, size);
+    *transaction = (i2c_async_transaction_t){
+        .address   = OLED_DISPLAY_ADDRESS << 1,
+        .tx_data   = frame,
+        .tx_length = 1 + size,
+        .timeout   = OLED_I2C_TIMEOUT,
+        .priority  = I2C_ASYNC_PRIORITY_LOW,
+    };
+    return i2c_async_submit(transaction);
+}
+
+// A failed transfer leaves the display memory unknown, so the whole display is sent again
+static void oled_queue_failed(void) {
+    oled_dirty = OLED_ALL_BLOCKS_MASK;
+#    ifdef OLED_DIFF_RENDER
+    oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#    endif
+}
+
+// The command buffers passed to oled_send_cmd() start with the I2C_CMD control byte
+#    define oled_render_cmd(data, size) oled_queue_send(I2C_CMD, &(data)[1], (size)-1)
+#    define oled_render_data(data, size) oled_queue_send(I2C_DATA, data, size)
+#else
+#    define oled_render_cmd oled_send_cmd
+#    define oled_render_data oled_send_data
+#endif
+
 // Transmit/Write Funcs.
 __attribute__((weak)) bool oled_send_cmd(const uint8_t *data, uint16_t size) {
 #if defined(OLED_TRANSPORT_SPI)
@@ -201,6 +279,10 @@ __attribute__((weak)) bool oled_send_cmd(const uint8_t *data, uint16_t size) {
     spi_stop();
     return true;
 #elif defined(OLED_TRANSPORT_I2C)
+#    ifdef OLED_QUEUED_RENDER
+    // Commands must not land between a queued addressing command and its data
+    oled_queue_wait();
+#    endif
     i2c_status_t status = i2c_transmit((OLED_DISPLAY_ADDRESS << 1), data, size, OLED_I2C_TIMEOUT);
 
     return (status == I2C_STATUS_SUCCESS);
@@ -253,6 +335,9 @@ __attribute__((weak)) bool oled_send_data(const uint8_t *data, uint16_t size) {
     spi_stop();
     return true;
 #elif defined(OLED_TRANSPORT_I2C)
+#    ifdef OLED_QUEUED_RENDER
+    oled_queue_wait();
+#    endif
     i2c_status_t status = i2c_writeReg((OLED_DISPLAY_ADDRESS << 1), I2C_DATA, data, size, OLED_I2C_TIMEOUT);
     return (status == I2C_STATUS_SUCCESS);
 #endif
@@ -368,6 +453,9 @@ bool oled_init(oled_rotation_t rotation) {
 #endif
 
     oled_clear();
+#ifdef OLED_DIFF_RENDER
+    oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#endif
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
@@ -451,6 +539,110 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
+#ifdef OLED_DIFF_RENDER
+static inline bool oled_diff_byte_changed(uint16_t index) {
+    return oled_buffer[index] != oled_shadow_buffer[index] || (oled_shadow_stale & ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE)));
+}
+
+// Finds the next run of changed bytes at or after `from`, within a single page. Changed bytes separated by no more than
+// OLED_DIFF_RENDER_MERGE_GAP unchanged bytes are merged into the same run, as the addressing overhead outweighs resending them.
+static bool oled_diff_find_run(uint16_t from, uint16_t *start, uint16_t *end) {
+    uint16_t index = from;
+    while (index < OLED_MATRIX_SIZE) {
+        // Skip over blocks which haven't been touched
+        if (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE)))) {
+            index = (index / OLED_BLOCK_SIZE + 1) * OLED_BLOCK_SIZE;
+            continue;
+        }
+        if (oled_diff_byte_changed(index)) {
+            break;
+        }
+        ++index;
+    }
+    if (index >= OLED_MATRIX_SIZE) {
+        return false;
+    }
+
+    const uint16_t page_end = (index / OLED_DISPLAY_WIDTH + 1) * OLED_DISPLAY_WIDTH;
+    uint16_t       last     = index;
+    for (uint16_t i = index + 1; i < page_end && (i - last) <= OLED_DIFF_RENDER_MERGE_GAP; ++i) {
+        if (oled_diff_byte_changed(i)) {
+            last = i;
+        }
+    }
+
+    *start = index;
+    *end   = last;
+    return true;
+}
+
+// Sends the inclusive range of the buffer to the display as a single addressing window. Ranges spanning multiple pages
+// must start and end on page boundaries.
+static bool oled_diff_send_window(uint16_t start, uint16_t end) {
+    const uint8_t start_page   = start / OLED_DISPLAY_WIDTH;
+    const uint8_t start_column = start % OLED_DISPLAY_WIDTH;
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+    uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, start_column + OLED_COLUMN_OFFSET, end % OLED_DISPLAY_WIDTH + OLED_COLUMN_OFFSET, PAGE_ADDR, start_page, end / OLED_DISPLAY_WIDTH};
+#    else
+    // Page Addressing Mode has no end bound, so windows never span more than one page
+    uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR | start_page, PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f), PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f)};
+#    endif
+    if (!oled_render_cmd(display_start, ARRAY_SIZE(display_start))) {
+        print("oled_render offset command failed\n");
+        return false;
+    }
+    if (!oled_render_data(&oled_buffer[start], end - start + 1)) {
+        print("oled_render data failed\n");
+        return false;
+    }
+    // Queued transfers have taken their copy of the data already, if they later fail the whole shadow is marked stale
+    memcpy(&oled_shadow_buffer[start], &oled_buffer[start], end - start + 1);
+    return true;
+}
+
+// Marks all blocks which lie entirely before `index` as up to date
+static void oled_diff_mark_clean_before(uint16_t index) {
+    const uint8_t blocks = index / OLED_BLOCK_SIZE;
+    if (blocks >= OLED_BLOCK_COUNT) {
+        oled_dirty        = 0;
+        oled_shadow_stale = 0;
+    } else if (blocks > 0) {
+        const OLED_BLOCK_TYPE mask = ((OLED_BLOCK_TYPE)1 << blocks) - 1;
+        oled_dirty &= ~mask;
+        oled_shadow_stale &= ~mask;
+    }
+}
+
+// Renders only the bytes which differ from what was last sent to the display
+static void oled_render_diff(bool all) {
+    uint16_t start, end;
+    bool     have_run      = oled_diff_find_run(0, &start, &end);
+    uint8_t  num_processed = 0;
+    while (have_run && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) {
+        uint16_t next_start, next_end;
+        bool     have_next = oled_diff_find_run(end + 1, &next_start, &next_end);
+#    if OLED_IC_HAS_HORIZONTAL_MODE && !defined(OLED_QUEUED_RENDER)
+        // Consecutive full pages are contiguous in display memory, so can be sent as one window. Queued transfers are
+        // limited to a single page.
+        while (have_next && start % OLED_DISPLAY_WIDTH == 0 && (end + 1) % OLED_DISPLAY_WIDTH == 0 && next_start == end + 1 && (next_end + 1) % OLED_DISPLAY_WIDTH == 0) {
+            end       = next_end;
+            have_next = oled_diff_find_run(end + 1, &next_start, &next_end);
+        }
+#    endif
+
+        if (!oled_diff_send_window(start, end)) {
+            return;
+        }
+
+        have_run = have_next;
+        start    = next_start;
+        end      = next_end;
+    }
+
+    oled_diff_mark_clean_before(have_run ? start : OLED_MATRIX_SIZE);
+}
+#endif // OLED_DIFF_RENDER
+
 void oled_render_dirty(bool all) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
@@ -461,6 +653,21 @@ void oled_render_dirty(bool all) {
     // Turn on display if it is off
     oled_on();
 
+#ifdef OLED_QUEUED_RENDER
+    // The previous render is still being sent, the blocks stay dirty until the next call
+    if (!oled_queue_idle() && !all) {
+        return;
+    }
+#endif
+
+#ifdef OLED_DIFF_RENDER
+    // Rotated output is rearranged before sending, so diffing is only possible against unrotated display memory
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        oled_render_diff(all);
+        return;
+    }
+#endif
+
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
     while (oled_dirty && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
@@ -482,14 +689,14 @@ void oled_render_dirty(bool all) {
         }
 
         // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        if (!oled_render_cmd(display_start, ARRAY_SIZE(display_start))) {
             print("oled_render offset command failed\n");
             return;
         }
 
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            if (!oled_render_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
                 print("oled_render data failed\n");
                 return;
             }
@@ -506,7 +713,7 @@ void oled_render_dirty(bool all) {
 
 #if OLED_IC_HAS_HORIZONTAL_MODE
             // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            if (!oled_render_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
                 print("oled_render90 data failed\n");
                 return;
             }
@@ -518,13 +725,13 @@ void oled_render_dirty(bool all) {
                 // Send column & page position for all pages except the first one
                 if (i > 0) {
                     display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                    if (!oled_render_cmd(display_start, ARRAY_SIZE(display_start))) {
                         print("oled_render offset command failed\n");
                         return;
                     }
                 }
                 // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                if (!oled_render_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
                     print("oled_render90 data failed\n");
                     return;
                 }
@@ -883,6 +1090,10 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#ifdef OLED_DIFF_RENDER
+        // Hardware scrolling has shifted the display memory, so its contents no longer match the shadow copy
+        oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#endif
     }
     return !oled_scrolling;
 }
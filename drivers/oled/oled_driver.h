@@ -321,6 +321,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_UPDATE_PROCESS_LIMIT 1
 #endif
 
+#if !defined(OLED_DIFF_RENDER_MERGE_GAP)
+#    define OLED_DIFF_RENDER_MERGE_GAP 8
+#endif
+
 typedef struct __attribute__((__packed__)) {
     uint8_t *current_element;
     uint16_t remaining_element_count;
@@ -14,8 +14,28 @@ extern bool touchpad_init;
 void RAP_ReadBytes(uint8_t address, uint8_t* data, uint8_t count) {
     uint8_t cmdByte = READ_MASK | address; // Form the READ command byte
     if (touchpad_init) {
+        i2c_status_t status;
+#ifdef I2C_ASYNC_ENABLE
+        // Queued ahead of any LED or display flushes, so pointer reports aren't delayed by them
+        i2c_async_transaction_t command = {
+            .address   = CIRQUE_PINNACLE_ADDR << 1,
+            .tx_data   = &cmdByte,
+            .tx_length = sizeof(cmdByte),
+            .timeout   = CIRQUE_PINNACLE_TIMEOUT,
+            .priority  = I2C_ASYNC_PRIORITY_HIGH,
+        };
+        i2c_async_transaction_t read = command;
+        read.rx_data                 = data;
+        read.rx_length               = count;
+        i2c_async_submit(&command);
+        i2c_async_submit(&read);
+        i2c_async_wait(&command);
+        status = i2c_async_wait(&read);
+#else
         i2c_writeReg(CIRQUE_PINNACLE_ADDR << 1, cmdByte, NULL, 0, CIRQUE_PINNACLE_TIMEOUT);
-        if (i2c_readReg(CIRQUE_PINNACLE_ADDR << 1, cmdByte, data, count, CIRQUE_PINNACLE_TIMEOUT) != I2C_STATUS_SUCCESS) {
+        status = i2c_readReg(CIRQUE_PINNACLE_ADDR << 1, cmdByte, data, count, CIRQUE_PINNACLE_TIMEOUT);
+#endif
+        if (status != I2C_STATUS_SUCCESS) {
             pd_dprintf("error cirque_pinnacle i2c_readReg\n");
             touchpad_init = false;
         }
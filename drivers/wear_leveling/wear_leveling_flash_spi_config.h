@@ -23,6 +23,11 @@
 #    define BACKING_STORE_WRITE_SIZE 8
 #endif
 
+// Erase a single sector at a time during incremental consolidation
+#ifndef BACKING_STORE_ERASE_SIZE
+#    define BACKING_STORE_ERASE_SIZE (EXTERNAL_FLASH_SECTOR_SIZE)
+#endif
+
 // The space allocated by the block
 #ifndef WEAR_LEVELING_BACKING_SIZE
 #    define WEAR_LEVELING_BACKING_SIZE ((EXTERNAL_FLASH_BLOCK_SIZE) * (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT))
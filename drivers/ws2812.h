@@ -56,7 +56,10 @@
 #    define WS2812_TRST_US 280
 #endif
 
-#if defined(RGBLED_NUM)
+#if defined(WS2812_SHARED_FRAMEBUFFER)
+// rgblight and RGB Matrix share the chain, see ws2812_framebuffer.h
+#    define WS2812_LED_COUNT (RGBLED_NUM + RGB_MATRIX_LED_COUNT)
+#elif defined(RGBLED_NUM)
 #    define WS2812_LED_COUNT RGBLED_NUM
 #elif defined(RGB_MATRIX_LED_COUNT)
 #    define WS2812_LED_COUNT RGB_MATRIX_LED_COUNT
@@ -86,11 +86,29 @@ static const dacsample_t dac_buffer_trapezoid[AUDIO_DAC_BUFFER_SIZE] = {0x0,   0
 
 static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define dac_wavetable dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define dac_wavetable dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define dac_wavetable dac_buffer_trapezoid
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define dac_wavetable dac_buffer_square
+#endif
 
-static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
-static uint8_t active_tones_snapshot_length                        = 0;
+/* keep track of the sample position for each frequency, as a Q16.16 index into
+ * the wavetable, and how far it advances per sample; so that generating a
+ * sample needs no floating point math
+ */
+#define DAC_PHASE_WRAP ((uint32_t)AUDIO_DAC_BUFFER_SIZE << 16)
+static uint32_t dac_phase[AUDIO_MAX_SIMULTANEOUS_TONES]      = {0};
+static uint32_t dac_phase_step[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
+
+/* 1 / active_tones_snapshot_length as Q0.16, scaling the sum of the tones back
+ * into the sample range with one multiplication instead of a division per tone
+ */
+static uint32_t dac_mix_scale                = 0;
+static uint8_t  active_tones_snapshot_length = 0;
 
 typedef enum {
     OUTPUT_SHOULD_START,
@@ -121,52 +139,38 @@ __attribute__((weak)) uint16_t dac_value_generate(void) {
     /* doing additive wave synthesis over all currently playing tones = adding up
      * sine-wave-samples for each frequency, scaled by the number of active tones
      */
-    uint_fast16_t value     = 0;
-    float         frequency = 0.0f;
-
-    for (size_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
+    uint_fast32_t value = 0;
 
-        float new_dac_if = dac_if[i];
-        new_dac_if += frequency * ((float)AUDIO_DAC_BUFFER_SIZE / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
-
-        while (new_dac_if >= AUDIO_DAC_BUFFER_SIZE)
-            new_dac_if -= AUDIO_DAC_BUFFER_SIZE;
-        dac_if[i] = new_dac_if;
+    for (uint8_t i = 0; i < active_tones_snapshot_length; i++) {
+        uint32_t phase = dac_phase[i] + dac_phase_step[i];
+        if (phase >= DAC_PHASE_WRAP) {
+            phase -= DAC_PHASE_WRAP;
+        }
+        dac_phase[i] = phase;
 
         // Wavetable generation/lookup
-        size_t dac_i = (size_t)new_dac_if;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+        value += dac_wavetable[phase >> 16];
     }
 
-    return value;
+    // at most AUDIO_DAC_SAMPLE_MAX * 2^16, which fits 32 bits
+    return (value * dac_mix_scale) >> 16;
+}
+
+/**
+ * Q16.16 wavetable positions a tone of the given frequency advances per sample.
+ */
+static uint32_t dac_phase_step_for(float frequency) {
+    /*Note: the 2/3 are necessary to get the correct frequencies on the
+     *      DAC output (as measured with an oscilloscope), since the gpt
+     *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
+     *      is called twice per conversion.*/
+    float step = frequency * ((float)AUDIO_DAC_BUFFER_SIZE * 65536.0f / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
+
+    // a tone above the sample rate can't be played anyway, but must not step past the wrap around
+    if (step >= DAC_PHASE_WRAP) {
+        return DAC_PHASE_WRAP - 1;
+    }
+    return step;
 }
 
 /**
@@ -225,13 +229,14 @@ static void dac_end(DACDriver *dacp) {
             uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
             active_tones_snapshot_length = 0;
             // update the snapshot - once, and only on occasion that something changed;
-            // -> saves cpu cycles (?)
+            // this is the only place the floating point frequencies are converted
             for (uint8_t i = 0; i < active_tones; i++) {
                 float freq = audio_get_processed_frequency(i);
                 if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
+                    dac_phase_step[active_tones_snapshot_length++] = dac_phase_step_for(freq);
                 }
             }
+            dac_mix_scale = active_tones_snapshot_length > 0 ? (1UL << 16) / active_tones_snapshot_length : 0;
 
             if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
                 state = OUTPUT_OFF;
@@ -344,10 +349,11 @@ void audio_driver_start(void) {
     gptStartContinuous(&GPTD6, 2U);
 
     for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
-        active_tones_snapshot[i] = 0.0f;
+        dac_phase[i]      = 0;
+        dac_phase_step[i] = 0;
     }
     active_tones_snapshot_length = 0;
+    dac_mix_scale                = 0;
     state                        = OUTPUT_SHOULD_START;
 }
 
@@ -90,6 +90,15 @@
 #    endif
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+#    ifndef I2C_ASYNC_THREAD_PRIORITY
+#        define I2C_ASYNC_THREAD_PRIORITY (NORMALPRIO + 1)
+#    endif
+#    ifndef I2C_ASYNC_THREAD_STACK_SIZE
+#        define I2C_ASYNC_THREAD_STACK_SIZE 256
+#    endif
+#endif
+
 static uint8_t i2c_address;
 
 static const I2CConfig i2cconfig = {
@@ -124,12 +133,22 @@ static i2c_status_t i2c_epilogue(const msg_t status) {
 
     // From ChibiOS HAL: "After a timeout the driver must be stopped and
     // restarted because the bus is in an uncertain state." We also issue that
-    // hard stop in case of any error.
-    i2c_stop();
+    // hard stop in case of any error. The caller holds the bus lock.
+    i2cStop(&I2C_DRIVER);
 
     return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
 }
 
+#ifdef I2C_ASYNC_ENABLE
+// Serialises access to the bus between the blocking API and the asynchronous queue
+static MUTEX_DECL(i2c_bus_mutex);
+#    define i2c_lock() chMtxLock(&i2c_bus_mutex)
+#    define i2c_unlock() chMtxUnlock(&i2c_bus_mutex)
+#else
+#    define i2c_lock()
+#    define i2c_unlock()
+#endif
+
 __attribute__((weak)) void i2c_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -151,26 +170,35 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_start(uint8_t address) {
+    i2c_lock();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_unlock();
     return I2C_STATUS_SUCCESS;
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
-    msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    msg_t        status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
-    msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    msg_t        status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -180,11 +208,14 @@ i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data,
     }
     complete_packet[0] = regaddr;
 
-    msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    msg_t        status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -195,25 +226,139 @@ i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* da
     complete_packet[0] = regaddr >> 8;
     complete_packet[1] = regaddr & 0xFF;
 
-    msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), complete_packet, length + 2, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    msg_t        status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), complete_packet, length + 2, 0, 0, TIME_MS2I(timeout));
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
-    msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    msg_t        status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
-    uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
-    msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    uint8_t      register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
+    msg_t        status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
+    i2c_status_t result             = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 void i2c_stop(void) {
+    i2c_lock();
     i2cStop(&I2C_DRIVER);
+    i2c_unlock();
+}
+
+#ifdef I2C_ASYNC_ENABLE
+// Pending transactions, ordered by priority and then by submission order
+static i2c_async_transaction_t* i2c_async_queue = NULL;
+static SEMAPHORE_DECL(i2c_async_pending, 0);
+// Threads waiting in i2c_async_wait()
+static THREADS_QUEUE_DECL(i2c_async_waiters);
+
+static THD_WORKING_AREA(waI2CAsyncThread, I2C_ASYNC_THREAD_STACK_SIZE);
+static THD_FUNCTION(I2CAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chSemWait(&i2c_async_pending);
+
+        chSysLock();
+        i2c_async_transaction_t* transaction = i2c_async_queue;
+        i2c_async_queue                      = transaction->next;
+        chSysUnlock();
+
+        // The transfer itself is interrupt/DMA driven, this thread sleeps until it completes
+        i2c_lock();
+        i2c_address = transaction->address;
+        i2cStart(&I2C_DRIVER, &i2cconfig);
+        msg_t status;
+        if (transaction->tx_length > 0) {
+            status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), transaction->tx_data, transaction->tx_length, transaction->rx_data, transaction->rx_length, TIME_MS2I(transaction->timeout));
+        } else {
+            status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), transaction->rx_data, transaction->rx_length, TIME_MS2I(transaction->timeout));
+        }
+        i2c_status_t result = i2c_epilogue(status);
+        i2c_unlock();
+
+        // The callback runs while the transaction is still busy, so the
+        // caller can't resubmit or reuse it until the callback returned
+        transaction->status = result;
+        if (transaction->callback) {
+            transaction->callback(transaction, result);
+        }
+
+        chSysLock();
+        transaction->busy = false;
+        chThdDequeueAllI(&i2c_async_waiters, MSG_OK);
+        chSchRescheduleS();
+        chSysUnlock();
+    }
+}
+
+/**
+ * @brief Queues a transaction to be performed by the I2C thread. Higher
+ * priority transactions are started before any queued lower priority ones,
+ * but never preempt a transfer which is already on the bus.
+ *
+ * @param transaction caller-owned transaction, must not already be queued
+ * @return true if the transaction was queued
+ */
+bool i2c_async_submit(i2c_async_transaction_t* transaction) {
+    static bool thread_started = false;
+    if (transaction->busy || (transaction->tx_length == 0 && transaction->rx_length == 0)) {
+        return false;
+    }
+
+    if (!thread_started) {
+        thread_started = true;
+        chThdCreateStatic(waI2CAsyncThread, sizeof(waI2CAsyncThread), I2C_ASYNC_THREAD_PRIORITY, I2CAsyncThread, NULL);
+    }
+
+    transaction->busy   = true;
+    transaction->status = I2C_STATUS_SUCCESS;
+
+    chSysLock();
+    i2c_async_transaction_t** slot = &i2c_async_queue;
+    while (*slot && (*slot)->priority >= transaction->priority) {
+        slot = &(*slot)->next;
+    }
+    transaction->next = *slot;
+    *slot             = transaction;
+    chSemSignalI(&i2c_async_pending);
+    chSchRescheduleS();
+    chSysUnlock();
+
+    return true;
+}
+
+bool i2c_async_is_busy(const i2c_async_transaction_t* transaction) {
+    return transaction->busy;
+}
+
+/**
+ * @brief Sleeps until a queued transaction has completed. Returns at once if
+ * the transaction isn't queued.
+ *
+ * @return i2c_status_t the result of the transaction
+ */
+i2c_status_t i2c_async_wait(const i2c_async_transaction_t* transaction) {
+    chSysLock();
+    while (transaction->busy) {
+        chThdEnqueueTimeoutS(&i2c_async_waiters, TIME_INFINITE);
+    }
+    chSysUnlock();
+    return transaction->status;
 }
+#endif // I2C_ASYNC_ENABLE
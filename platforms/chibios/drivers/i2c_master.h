@@ -25,6 +25,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 typedef int16_t i2c_status_t;
 
@@ -41,3 +42,38 @@ i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* da
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 void         i2c_stop(void);
+
+#ifdef I2C_ASYNC_ENABLE
+typedef enum {
+    I2C_ASYNC_PRIORITY_LOW,
+    I2C_ASYNC_PRIORITY_NORMAL,
+    I2C_ASYNC_PRIORITY_HIGH,
+} i2c_async_priority_t;
+
+struct i2c_async_transaction_t;
+typedef void (*i2c_async_callback_t)(struct i2c_async_transaction_t* transaction, i2c_status_t status);
+
+/* A queued transaction. The struct and both data buffers are owned by the
+ * caller and must stay valid until the transaction completes. The transmit
+ * phase is performed first, followed by the receive phase; either one may be
+ * empty but not both.
+ */
+typedef struct i2c_async_transaction_t {
+    uint8_t                         address;
+    const uint8_t*                  tx_data;
+    uint16_t                        tx_length;
+    uint8_t*                        rx_data;
+    uint16_t                        rx_length;
+    uint16_t                        timeout;
+    i2c_async_priority_t            priority;
+    i2c_async_callback_t            callback; // invoked from the I2C thread once the transaction completes, may be NULL, must not resubmit it
+    void*                           user_data;
+    volatile bool                   busy; // internal state below, managed by the driver
+    volatile i2c_status_t           status;
+    struct i2c_async_transaction_t* next;
+} i2c_async_transaction_t;
+
+bool         i2c_async_submit(i2c_async_transaction_t* transaction);
+bool         i2c_async_is_busy(const i2c_async_transaction_t* transaction);
+i2c_status_t i2c_async_wait(const i2c_async_transaction_t* transaction);
+#endif // I2C_ASYNC_ENABLE
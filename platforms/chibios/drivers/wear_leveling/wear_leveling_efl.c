@@ -87,6 +87,17 @@ bool backing_store_init(void) {
 
 #endif // defined(WEAR_LEVELING_EFL_FIRST_SECTOR)
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Erasing a block erases whole sectors, so a sector reaching past the end of its block would take part of the active bank with it -- e.g. the mixed sector sizes of STM32F4xx
+    for (flash_sector_t i = 0; sector_count != UINT16_MAX && i < sector_count; ++i) {
+        uint32_t offset = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        uint32_t size   = flashGetSectorSize(flash, first_sector + i);
+        if ((offset % (BACKING_STORE_ERASE_SIZE)) + size > (BACKING_STORE_ERASE_SIZE)) {
+            chSysHalt("Flash sectors do not fit within BACKING_STORE_ERASE_SIZE, incremental consolidation can't be used");
+        }
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     return true;
 }
 
@@ -120,6 +131,39 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_block(uint32_t address) {
+#    ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#    endif
+
+    // Erase each sector that starts within the requested block -- backing_store_init() ensures none of them reach past it
+    bool          ret = true;
+    flash_error_t status;
+    for (int i = 0; i < sector_count; ++i) {
+        uint32_t offset = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        if (offset < address || offset >= address + (BACKING_STORE_ERASE_SIZE)) {
+            continue;
+        }
+
+        // Kick off the sector erase
+        status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        // Wait for the erase to complete
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+    }
+
+    bs_dprintf("Backing store block erase took %ldms to complete\n", ((long)(timer_read32() - start)));
+    return ret;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
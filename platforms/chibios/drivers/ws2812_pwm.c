@@ -1,6 +1,7 @@
 #include "ws2812.h"
 #include "gpio.h"
 #include "chibios_config.h"
+#include <string.h>
 
 /* Adapted from https://github.com/joewa/WS2812-LED-Driver_ChibiOS/ */
 
@@ -291,7 +292,105 @@ typedef uint16_t ws2812_buffer_t;
 typedef uint8_t ws2812_buffer_t;
 #endif
 
+#ifdef WS2812_PWM_STREAMING
+#    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
+#        error "WS2812_PWM_STREAMING is only supported on STM32"
+#    endif
+#    ifndef WS2812_PWM_STREAMING_LEDS
+#        define WS2812_PWM_STREAMING_LEDS 4
+#    endif
+
+/**
+ * @brief   Number of bits encoded into each half of the DMA buffer
+ *
+ * The DMA runs over both halves in a circle. Whenever it finishes one half,
+ * the interrupt encodes the next LEDs into it while the other half is sent.
+ */
+#    define WS2812_HALF_BIT_N (WS2812_PWM_STREAMING_LEDS * WS2812_COLOR_BITS)
+#    define WS2812_HALF_N ((WS2812_BIT_N + WS2812_HALF_BIT_N - 1) / WS2812_HALF_BIT_N) /**< Halves needed for a frame */
+
+static ws2812_buffer_t    ws2812_frame_buffer[WS2812_HALF_BIT_N * 2];       /**< Buffer for two halves */
+static uint8_t            ws2812_colors[WS2812_LED_COUNT][WS2812_CHANNELS]; /**< Colors of the frame, r, g, b(, w) */
+static volatile uint16_t  ws2812_half_sent;                                 /**< Halves sent of the frame */
+static volatile bool      ws2812_streaming      = false;                    /**< Whether a frame is being sent */
+static thread_reference_t ws2812_waiting_thread = NULL;                     /**< Thread waiting for the frame to be sent */
+#else
 static ws2812_buffer_t ws2812_frame_buffer[WS2812_BIT_N + 1]; /**< Buffer for a frame */
+#endif
+
+#ifdef WS2812_PWM_STREAMING
+/* --- PRIVATE FUNCTIONS ---------------------------------------------------- */
+
+static inline ws2812_buffer_t ws2812_duty_cycle(uint8_t value, uint8_t bit) {
+    return ((value >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+}
+
+/**
+ * @brief   Encode one half of the DMA buffer
+ *
+ * @param[in] half:                 The half of the frame to encode, LEDs past the end are sent as reset bits
+ */
+static void ws2812_fill_half(uint16_t half) {
+    ws2812_buffer_t *buffer = &ws2812_frame_buffer[(half & 1) * WS2812_HALF_BIT_N];
+    uint16_t         led    = half * WS2812_PWM_STREAMING_LEDS;
+
+    for (uint8_t i = 0; i < WS2812_PWM_STREAMING_LEDS; i++, led++) {
+        if (led >= WS2812_LED_COUNT) {
+            memset(&buffer[WS2812_BIT(i, 0, 7)], 0, WS2812_COLOR_BITS * sizeof(ws2812_buffer_t));
+            continue;
+        }
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            buffer[WS2812_RED_BIT(i, bit)]   = ws2812_duty_cycle(ws2812_colors[led][0], bit);
+            buffer[WS2812_GREEN_BIT(i, bit)] = ws2812_duty_cycle(ws2812_colors[led][1], bit);
+            buffer[WS2812_BLUE_BIT(i, bit)]  = ws2812_duty_cycle(ws2812_colors[led][2], bit);
+#    ifdef RGBW
+            buffer[WS2812_WHITE_BIT(i, bit)] = ws2812_duty_cycle(ws2812_colors[led][3], bit);
+#    endif
+        }
+    }
+}
+
+/**
+ * @brief   DMA half and full transfer interrupt
+ *
+ * Refills the half that has just been sent, or stops the DMA once the reset
+ * bits at the end of the frame are out. The output then stays low, as the
+ * last duty cycle sent was zero.
+ */
+static void ws2812_dma_isr(void *param, uint32_t flags) {
+    (void)param;
+    if (!(flags & (STM32_DMA_ISR_HTIF | STM32_DMA_ISR_TCIF))) {
+        return;
+    }
+
+    ws2812_half_sent++;
+    if (ws2812_half_sent >= WS2812_HALF_N) {
+        dmaStreamDisable(WS2812_DMA_STREAM);
+        osalSysLockFromISR();
+        ws2812_streaming = false;
+        osalThreadResumeI(&ws2812_waiting_thread, MSG_OK);
+        osalSysUnlockFromISR();
+        return;
+    }
+
+    ws2812_fill_half(ws2812_half_sent + 1);
+}
+
+/**
+ * @brief   Start sending the frame held in @ref ws2812_colors
+ */
+static void ws2812_start_frame(void) {
+    ws2812_half_sent = 0;
+    ws2812_fill_half(0);
+    ws2812_fill_half(1);
+
+    ws2812_streaming = true;
+    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer);
+    dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_HALF_BIT_N * 2);
+    dmaStreamEnable(WS2812_DMA_STREAM);
+}
+#endif
 
 /* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
 /*
@@ -301,12 +400,14 @@ static ws2812_buffer_t ws2812_frame_buffer[WS2812_BIT_N + 1]; /**< Buffer for a
  */
 
 void ws2812_init(void) {
+#ifndef WS2812_PWM_STREAMING
     // Initialize led frame buffer
     uint32_t i;
     for (i = 0; i < WS2812_COLOR_BIT_N; i++)
         ws2812_frame_buffer[i] = WS2812_DUTYCYCLE_0; // All color bits are zero duty cycle
     for (i = 0; i < WS2812_RESET_BIT_N; i++)
         ws2812_frame_buffer[i + WS2812_COLOR_BIT_N] = 0; // All reset bits are zero
+#endif
 
     palSetLineMode(WS2812_DI_PIN, WS2812_OUTPUT_MODE);
 
@@ -333,13 +434,23 @@ void ws2812_init(void) {
     dmaStreamSetSource(WS2812_DMA_STREAM, ws2812_frame_buffer);
     dmaStreamSetDestination(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
     dmaStreamSetMode(WS2812_DMA_STREAM, WB32_DMA_CHCFG_HWHIF(WS2812_DMA_CHANNEL) | WB32_DMA_CHCFG_DIR_M2P | WB32_DMA_CHCFG_PSIZE_WORD | WB32_DMA_CHCFG_MSIZE_WORD | WB32_DMA_CHCFG_MINC | WB32_DMA_CHCFG_CIRC | WB32_DMA_CHCFG_TCIE | WB32_DMA_CHCFG_PL(3));
+#elif defined(WS2812_PWM_STREAMING)
+    // Interrupt at each half of the buffer to encode the next LEDs into it
+    dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, ws2812_dma_isr, NULL);
+    dmaStreamSetPeripheral(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1]));
+    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer);
+    dmaStreamSetMode(WS2812_DMA_STREAM, STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_DMA_PERIPHERAL_WIDTH | WS2812_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3) | STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE);
 #else
     dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, NULL, NULL);
     dmaStreamSetPeripheral(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
     dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer);
     dmaStreamSetMode(WS2812_DMA_STREAM, STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_DMA_PERIPHERAL_WIDTH | WS2812_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3));
 #endif
+#ifdef WS2812_PWM_STREAMING
+    dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_HALF_BIT_N * 2);
+#else
     dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
+#endif
     // M2P: Memory 2 Periph; PL: Priority Level
 
 #if (STM32_DMA_SUPPORTS_DMAMUX == TRUE)
@@ -347,8 +458,10 @@ void ws2812_init(void) {
     dmaSetRequestSource(WS2812_DMA_STREAM, WS2812_DMAMUX_ID);
 #endif
 
-    // Start DMA
+#ifndef WS2812_PWM_STREAMING
+    // Start DMA, streaming frames are started by ws2812_setleds()
     dmaStreamEnable(WS2812_DMA_STREAM);
+#endif
 
     // Configure PWM
     // NOTE: It's required that preload be enabled on the timer channel CCR register. This is currently enabled in the
@@ -359,23 +472,37 @@ void ws2812_init(void) {
 }
 
 void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
+#ifdef WS2812_PWM_STREAMING
+    // Colors are encoded as the frame is sent
+    ws2812_colors[led_number][0] = r;
+    ws2812_colors[led_number][1] = g;
+    ws2812_colors[led_number][2] = b;
+#else
     // Write color to frame buffer
     for (uint8_t bit = 0; bit < 8; bit++) {
         ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
         ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
         ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
     }
+#endif
 }
 void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+#ifdef WS2812_PWM_STREAMING
+    ws2812_write_led(led_number, r, g, b);
+#    ifdef RGBW
+    ws2812_colors[led_number][3] = w;
+#    endif
+#else
     // Write color to frame buffer
     for (uint8_t bit = 0; bit < 8; bit++) {
         ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
         ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
         ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-#ifdef RGBW
+#    ifdef RGBW
         ws2812_frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = ((w >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-#endif
+#    endif
     }
+#endif
 }
 
 // Setleds for standard RGB
@@ -386,6 +513,16 @@ void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
         s_init = true;
     }
 
+#ifdef WS2812_PWM_STREAMING
+    // The previous frame is usually long gone by now, but its colors must not change while it is still being sent,
+    // so sleep until the DMA interrupt is done with it
+    osalSysLock();
+    if (ws2812_streaming) {
+        osalThreadSuspendS(&ws2812_waiting_thread);
+    }
+    osalSysUnlock();
+#endif
+
     for (uint16_t i = 0; i < leds; i++) {
 #ifdef RGBW
         ws2812_write_led_rgbw(i, ledarray[i].r, ledarray[i].g, ledarray[i].b, ledarray[i].w);
@@ -393,4 +530,8 @@ void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
         ws2812_write_led(i, ledarray[i].r, ledarray[i].g, ledarray[i].b);
 #endif
     }
+
+#ifdef WS2812_PWM_STREAMING
+    ws2812_start_frame();
+#endif
 }
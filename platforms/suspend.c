@@ -41,9 +41,13 @@ __attribute__((weak)) void suspend_wakeup_init_kb(void) {
  * FIXME: needs doc
  */
 bool suspend_wakeup_condition(void) {
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+    // the scan thread keeps scanning, so its last scan is read rather than scanning alongside it
+#else
     matrix_power_up();
     matrix_scan();
     matrix_power_down();
+#endif
     for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
         if (matrix_get_row(r)) return true;
     }
@@ -0,0 +1,89 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "budget_common.hpp"
+
+extern "C" {
+#include "action.h"
+#include "action_layer.h"
+
+// Layers that map every key, all others are transparent
+static layer_state_t mapped_layers = 1;
+
+action_t action_for_key(uint8_t layer, keypos_t key) {
+    budget_keymap_lookups++;
+    return (action_t){.code = (uint16_t)((mapped_layers >> layer) & 1 ? ACTION_KEY(KC_A) : ACTION_TRANSPARENT)};
+}
+
+bool disable_action_cache = false;
+
+void clear_keyboard_but_mods(void) {}
+}
+
+class ActionLayerBudget : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        layer_clear();
+        default_layer_set(1);
+        mapped_layers = 1;
+    }
+};
+
+TEST_F(ActionLayerBudget, LookupWithAllLayersOn) {
+    layer_state_set(~(layer_state_t)0);
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            budget_reset();
+            EXPECT_EQ(layer_switch_get_layer((keypos_t){.col = col, .row = row}), 0);
+            BudgetCounters counters = budget_read();
+            EXPECT_LE(counters.keymap_lookups, MAX_LAYER);
+            EXPECT_LE(counters.loop_steps, LOOP_STEPS(MAX_LAYER));
+            EXPECT_EQ(counters.eeprom_reads, 0);
+        }
+    }
+}
+
+TEST_F(ActionLayerBudget, LookupStopsAtTopMappedLayer) {
+    layer_state_set(~(layer_state_t)0);
+    mapped_layers = (layer_state_t)1 << (MAX_LAYER - 1) | 1;
+
+    budget_reset();
+    EXPECT_EQ(layer_switch_get_layer((keypos_t){.col = 0, .row = 0}), MAX_LAYER - 1);
+    EXPECT_EQ(budget_read().keymap_lookups, 1);
+}
+
+TEST_F(ActionLayerBudget, PressAndReleaseThroughSourceLayerCache) {
+    layer_state_set(~(layer_state_t)0);
+    keypos_t key = {.col = MATRIX_COLS - 1, .row = MATRIX_ROWS - 1};
+
+    budget_reset();
+    store_or_get_action(true, key);
+    BudgetCounters press = budget_read();
+    EXPECT_LE(press.keymap_lookups, MAX_LAYER + 1);
+    EXPECT_LE(press.loop_steps, LOOP_STEPS(MAX_LAYER));
+    EXPECT_EQ(press.eeprom_reads, 0);
+
+    // The release reads its layer from the cache instead of searching again
+    layer_clear();
+    budget_reset();
+    store_or_get_action(false, key);
+    BudgetCounters release = budget_read();
+    EXPECT_EQ(release.keymap_lookups, 1);
+    EXPECT_LE(release.loop_steps, LOOP_STEPS(MAX_LAYER_BITS));
+    EXPECT_EQ(release.eeprom_reads, 0);
+}
+
+TEST_F(ActionLayerBudget, LayerStateChanges) {
+    for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+        budget_reset();
+        layer_on(layer);
+        layer_off(layer);
+        layer_invert(layer);
+        BudgetCounters counters = budget_read();
+        EXPECT_EQ(counters.keymap_lookups, 0);
+        EXPECT_LE(counters.loop_steps, 3 * LOOP_STEPS(MAX_LAYER));
+        EXPECT_EQ(counters.eeprom_reads, 0);
+    }
+}
@@ -0,0 +1,58 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "budget_common.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+// Hit counts of the basic blocks run since budget_reset(), keyed by their address
+#define BUDGET_BLOCK_SLOTS (1 << 14)
+
+static uintptr_t budget_block_addresses[BUDGET_BLOCK_SLOTS];
+static uint32_t  budget_block_hits[BUDGET_BLOCK_SLOTS];
+static uint32_t  budget_most_block_hits = 0;
+static bool      budget_counting        = false;
+uint32_t         budget_keymap_lookups  = 0;
+
+// The budget tests are built with -fsanitize-coverage=trace-pc, which calls
+// this at the start of every basic block executed
+extern "C" __attribute__((no_sanitize_coverage)) void __sanitizer_cov_trace_pc(void) {
+    if (!budget_counting) {
+        return;
+    }
+
+    uintptr_t address = (uintptr_t)__builtin_return_address(0);
+    size_t    slot    = (address >> 2) % BUDGET_BLOCK_SLOTS;
+    for (size_t probes = 0; budget_block_addresses[slot] != address; probes++) {
+        if (budget_block_addresses[slot] == 0) {
+            budget_block_addresses[slot] = address;
+            break;
+        }
+        if (probes == BUDGET_BLOCK_SLOTS) {
+            // more blocks than slots, can't happen with the modules measured here
+            __builtin_trap();
+        }
+        slot = (slot + 1) % BUDGET_BLOCK_SLOTS;
+    }
+
+    if (++budget_block_hits[slot] > budget_most_block_hits) {
+        budget_most_block_hits = budget_block_hits[slot];
+    }
+}
+
+__attribute__((no_sanitize_coverage)) void budget_reset(void) {
+    budget_counting = false;
+    reset_eeprom_read_counter();
+    reset_access_counter();
+    memset(budget_block_addresses, 0, sizeof(budget_block_addresses));
+    memset(budget_block_hits, 0, sizeof(budget_block_hits));
+    budget_most_block_hits = 0;
+    budget_keymap_lookups  = 0;
+    budget_counting        = true;
+}
+
+__attribute__((no_sanitize_coverage)) BudgetCounters budget_read(void) {
+    budget_counting = false;
+    return {budget_most_block_hits, budget_keymap_lookups, current_eeprom_read_counter(), current_access_counter()};
+}
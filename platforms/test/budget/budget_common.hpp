@@ -0,0 +1,34 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+
+extern "C" {
+uint32_t current_access_counter(void);
+void     reset_access_counter(void);
+uint32_t current_eeprom_read_counter(void);
+void     reset_eeprom_read_counter(void);
+}
+
+/**
+ * @brief Work done by a module under test between two calls of
+ * `budget_reset()` and `budget_read()`.
+ */
+struct BudgetCounters {
+    // the most times any one basic block ran, i.e. the steps of the busiest loop
+    uint32_t loop_steps;
+    uint32_t keymap_lookups;
+    uint32_t eeprom_reads;
+    uint32_t timer_reads;
+};
+
+/* A loop of `n` steps checks its condition up to `n + 1` times. */
+#define LOOP_STEPS(n) ((n) + 1)
+
+/** Keymap lookups made so far, counted by the keymap stubs of the tests. */
+extern uint32_t budget_keymap_lookups;
+
+void           budget_reset(void);
+BudgetCounters budget_read(void);
@@ -0,0 +1,88 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "budget_common.hpp"
+
+#include <algorithm>
+
+extern "C" {
+#include "debounce.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+// One pass over every key of the matrix, row by row
+#define MATRIX_PASS (MATRIX_ROWS * LOOP_STEPS(MATRIX_COLS))
+
+class DebounceBudget : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(1000);
+        budget_reset();
+        debounce_init(MATRIX_ROWS);
+        init_ = budget_read();
+        std::fill(std::begin(raw_), std::end(raw_), 0);
+        std::fill(std::begin(cooked_), std::end(cooked_), 0);
+    }
+
+    void TearDown() override {
+        debounce_free();
+    }
+
+    // Runs one scan and returns the work debounce() did for it
+    BudgetCounters scan(bool changed = false) {
+        budget_reset();
+        debounce(raw_, cooked_, MATRIX_ROWS, changed);
+        BudgetCounters counters = budget_read();
+        advance_time(1);
+        return counters;
+    }
+
+    void toggle(uint8_t row, uint8_t col) {
+        raw_[row] ^= (matrix_row_t)1 << col;
+    }
+
+    BudgetCounters init_;
+    matrix_row_t   raw_[MATRIX_ROWS];
+    matrix_row_t   cooked_[MATRIX_ROWS];
+};
+
+TEST_F(DebounceBudget, Init) {
+    EXPECT_LE(init_.loop_steps, MATRIX_PASS);
+    EXPECT_EQ(init_.eeprom_reads, 0);
+}
+
+TEST_F(DebounceBudget, IdleScan) {
+    for (int i = 0; i < 100; i++) {
+        BudgetCounters counters = scan();
+        // Per-row algorithms may check each row, nothing may look at each key
+        EXPECT_LE(counters.loop_steps, LOOP_STEPS(MATRIX_ROWS)) << "at scan " << i;
+        EXPECT_LE(counters.timer_reads, 1) << "at scan " << i;
+        EXPECT_EQ(counters.eeprom_reads, 0) << "at scan " << i;
+    }
+}
+
+TEST_F(DebounceBudget, TypingBurst) {
+    uint32_t most = 0;
+
+    // Keys all over the matrix, pressed and released one scan apart, with
+    // every state change followed by DEBOUNCE * 2 scans without changes
+    for (int i = 0; i < 20; i++) {
+        uint8_t row = (i * 7) % MATRIX_ROWS;
+        uint8_t col = (i * 13) % MATRIX_COLS;
+        for (int edge = 0; edge < 2; edge++) {
+            toggle(row, col);
+            for (int j = 0; j <= DEBOUNCE * 2; j++) {
+                BudgetCounters counters = scan(j == 0);
+                EXPECT_LE(counters.loop_steps, MATRIX_PASS) << "at key " << i;
+                EXPECT_LE(counters.timer_reads, 1) << "at key " << i;
+                EXPECT_EQ(counters.eeprom_reads, 0) << "at key " << i;
+                most = std::max(most, counters.loop_steps);
+            }
+        }
+    }
+    RecordProperty("loop_steps_most", most);
+}
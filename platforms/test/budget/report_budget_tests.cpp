@@ -0,0 +1,65 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "budget_common.hpp"
+
+extern "C" {
+#include "action_util.h"
+#include "host.h"
+#include "keycode.h"
+#include "keycode_config.h"
+#include "report.h"
+
+static report_keyboard_t budget_keyboard_report;
+static report_nkro_t     budget_nkro_report;
+
+uint8_t            keyboard_protocol = 1;
+keymap_config_t    keymap_config;
+report_keyboard_t *keyboard_report = &budget_keyboard_report;
+report_nkro_t     *nkro_report     = &budget_nkro_report;
+}
+
+class ReportBudget : public ::testing::TestWithParam<bool> {
+   protected:
+    void SetUp() override {
+        keymap_config.nkro = GetParam();
+        clear_keys_from_report();
+    }
+};
+
+// Adding, finding and removing a key may look at each slot of the 6KRO
+// report once, but never at each bit of the NKRO report
+#define KEY_BUDGET LOOP_STEPS(keymap_config.nkro ? 0 : KEYBOARD_REPORT_KEYS)
+
+TEST_P(ReportBudget, AddAndRemoveKeys) {
+    // Fill all but one slot of the 6KRO report
+    for (uint8_t key = KC_1; key < KC_1 + KEYBOARD_REPORT_KEYS - 1; key++) {
+        add_key_to_report(key);
+    }
+
+    for (uint8_t key = KC_A; key <= KC_Z; key++) {
+        budget_reset();
+        add_key_to_report(key);
+        EXPECT_TRUE(is_key_pressed(key));
+        del_key_from_report(key);
+        EXPECT_FALSE(is_key_pressed(key));
+        BudgetCounters counters = budget_read();
+        EXPECT_LE(counters.loop_steps, 4 * KEY_BUDGET);
+        EXPECT_EQ(counters.eeprom_reads, 0);
+    }
+}
+
+TEST_P(ReportBudget, ScanWholeReport) {
+    size_t report_size = keymap_config.nkro ? NKRO_REPORT_BITS : KEYBOARD_REPORT_KEYS;
+
+    add_key_to_report(KC_SLASH);
+    budget_reset();
+    EXPECT_EQ(has_anykey(), 1);
+    EXPECT_EQ(get_first_key(), KC_SLASH);
+    BudgetCounters counters = budget_read();
+    EXPECT_LE(counters.loop_steps, 2 * LOOP_STEPS(report_size));
+    EXPECT_EQ(counters.eeprom_reads, 0);
+}
+
+INSTANTIATE_TEST_CASE_P(Protocols, ReportBudget, ::testing::Values(false, true), [](const ::testing::TestParamInfo<bool> &info) { return info.param ? "NKRO" : "SixKRO"; });
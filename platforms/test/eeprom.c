@@ -16,10 +16,20 @@
 
 #include "eeprom.h"
 
-static uint8_t buffer[TOTAL_EEPROM_BYTE_COUNT];
+static uint8_t  buffer[TOTAL_EEPROM_BYTE_COUNT];
+static uint32_t read_counter = 0;
+
+uint32_t current_eeprom_read_counter(void) {
+    return read_counter;
+}
+
+void reset_eeprom_read_counter(void) {
+    read_counter = 0;
+}
 
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uintptr_t offset = (uintptr_t)addr;
+    read_counter++;
     return buffer[offset];
 }
 
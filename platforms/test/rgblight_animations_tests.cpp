@@ -0,0 +1,207 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdlib.h>
+#include <vector>
+#include "gtest/gtest.h"
+
+// the config struct of rgblight is checked with C11 asserts
+#define _Static_assert static_assert
+
+extern "C" {
+#include "rgblight.h"
+
+void advance_time(uint32_t ms);
+
+static std::vector<rgb_led_t> last_frame;
+static uint16_t               frames;
+static uint32_t               frames_hash;
+
+// Only counts a frame when it differs from the last one, so the result
+// doesn't depend on how often an unchanged frame is sent again
+void ws2812_setleds(rgb_led_t *ledarray, uint16_t number_of_leds) {
+    std::vector<rgb_led_t> frame(ledarray, ledarray + number_of_leds);
+    if (frame.size() == last_frame.size() && memcmp(frame.data(), last_frame.data(), frame.size() * sizeof(rgb_led_t)) == 0) {
+        return;
+    }
+    last_frame = frame;
+    frames++;
+    // FNV-1a
+    for (const rgb_led_t &led : frame) {
+        for (uint8_t byte : {led.r, led.g, led.b}) {
+            frames_hash = (frames_hash ^ byte) * 16777619;
+        }
+    }
+}
+
+bool eeconfig_is_enabled(void) {
+    return true;
+}
+
+void eeconfig_init(void) {}
+}
+
+typedef struct {
+    uint8_t  mode;
+    uint16_t frames;
+    uint32_t hash;
+} recorded_animation_t;
+
+// Recorded from rgblight.c as it was before the animations were rewritten
+// (table driven dispatch and the swirl, snake and knight rewrites), by running
+// every mode for RGBLIGHT_ANIMATION_RUN_TIME ms over the full strip and then
+// over an effect range of the strip
+// clang-format off
+static const recorded_animation_t recorded_full[] = {
+    { 1,    1, 0x1212E2AB},
+    { 2,  100, 0xBA6210CB},
+    { 3,  128, 0xB8B39BFF},
+    { 4,  276, 0xA804A181},
+    { 5,  552, 0xB976FD29},
+    { 6,   25, 0x2F03B4B3},
+    { 7,   50, 0xC8B6DBC5},
+    { 8,  100, 0x1551A4D1},
+    { 9,   30, 0xB1D73325},
+    {10,   30, 0xA9AC6583},
+    {11,   60, 0x32185573},
+    {12,   60, 0x928D7E69},
+    {13,  150, 0x81B41291},
+    {14,  150, 0xDC7D8ED9},
+    {15,   30, 0xDD947532},
+    {16,   30, 0xF94BF7DD},
+    {17,   60, 0x1CB0D22D},
+    {18,   60, 0xDDF5B195},
+    {19,  150, 0xB5A297A2},
+    {20,  150, 0x21C3C9FD},
+    {21,   24, 0x45D933D9},
+    {22,   48, 0x2F3ADD1D},
+    {23,   97, 0xD6A4C0CE},
+    {24,   47, 0x0050E113},
+    {25,    1, 0xF50D05A5},
+    {26,    1, 0x007797A1},
+    {27,    1, 0x5C453D11},
+    {28,    1, 0xFCEA4F5F},
+    {29,    1, 0xFB3879F9},
+    {30,    1, 0xAD8D741D},
+    {31,    1, 0x56132C97},
+    {32,    1, 0x19B76B45},
+    {33,    1, 0x61CBE2BF},
+    {34,    1, 0xBDE45939},
+    {35,    3, 0x4D7256BB},
+    {36,    6, 0x296CC3E3},
+    {37,   65, 0x52CA8667},
+    {38,  165, 0xA2223259},
+    {39,  565, 0x65F7C44F},
+    {40,   65, 0x08B7BB78},
+    {41,  165, 0xD19129E3},
+    {42,  565, 0xF70E3CDB},
+};
+static const recorded_animation_t recorded_range[] = {
+    { 1,    1, 0xD36ED377},
+    { 2,  100, 0x2CF91C4B},
+    { 3,  128, 0x5FE3724F},
+    { 4,  276, 0x53672D19},
+    { 5,  552, 0xADF80081},
+    { 6,   25, 0x1A4DC7CF},
+    { 7,   50, 0xD6961BE1},
+    { 8,  100, 0x98355291},
+    { 9,   30, 0x3DC94ACF},
+    {10,   30, 0xD9004CB3},
+    {11,   60, 0x9A240555},
+    {12,   60, 0x8190BAF9},
+    {13,  150, 0xC86567D5},
+    {14,  150, 0xE3274E29},
+    {15,   30, 0x5F18B3B1},
+    {16,   30, 0xAC914125},
+    {17,   60, 0x73D7ACCD},
+    {18,   60, 0x787EE985},
+    {19,  150, 0xCB6BB9E1},
+    {20,  150, 0x4540FCA5},
+    {21,   24, 0x60465F73},
+    {22,   48, 0x02A850A7},
+    {23,   97, 0x009463EA},
+    {24,   47, 0x3B666C8B},
+    {25,    1, 0x7314D8E1},
+    {26,    1, 0x3C5C7B89},
+    {27,    1, 0x28700195},
+    {28,    1, 0x17B267FB},
+    {29,    1, 0xB22010DD},
+    {30,    1, 0xFA5613A5},
+    {31,    1, 0x820A3607},
+    {32,    1, 0x800C18AD},
+    {33,    1, 0x9DB70AF3},
+    {34,    1, 0x7E04314F},
+    {35,    3, 0x06266A43},
+    {36,    6, 0x35030463},
+    {37,   43, 0xA3D78443},
+    {38,  143, 0xF6BC8BD4},
+    {39,  543, 0xA15A238F},
+    {40,   43, 0xE7B635D1},
+    {41,  143, 0x121638D1},
+    {42,  543, 0x281A2DC8},
+};
+
+// clang-format on
+
+#define RGBLIGHT_ANIMATION_RUN_TIME 3000
+
+class RgblightAnimations : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        rgblight_enable_noeeprom();
+        rgblight_sethsv_noeeprom(10, 255, 255);
+        rgblight_set_speed_noeeprom(1);
+    }
+
+    static recorded_animation_t run(uint8_t mode) {
+        // twinkle picks its LEDs with rand()
+        srand(1);
+        rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+        last_frame.clear();
+        frames      = 0;
+        frames_hash = 2166136261;
+
+        rgblight_mode_noeeprom(mode);
+        for (uint16_t t = 0; t < RGBLIGHT_ANIMATION_RUN_TIME; t++) {
+            advance_time(1);
+            rgblight_task();
+        }
+        return (recorded_animation_t){mode, frames, frames_hash};
+    }
+
+    static void expect_recorded(const recorded_animation_t *recorded, size_t count) {
+        ASSERT_EQ(count, RGBLIGHT_MODES);
+        for (size_t i = 0; i < count; i++) {
+            recorded_animation_t actual = run(recorded[i].mode);
+            EXPECT_EQ(actual.frames, recorded[i].frames) << "mode " << +recorded[i].mode;
+            EXPECT_EQ(actual.hash, recorded[i].hash) << "mode " << +recorded[i].mode;
+        }
+    }
+};
+
+#ifdef RGBLIGHT_ANIMATIONS_RECORD
+// Prints the tables above for the rgblight.c this is built against
+TEST_F(RgblightAnimations, Record) {
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        if (pass) rgblight_set_effect_range(2, RGBLED_NUM - 4);
+        printf("static const recorded_animation_t recorded_%s[] = {\n", pass ? "range" : "full");
+        for (uint8_t mode = 1; mode <= RGBLIGHT_MODES; mode++) {
+            recorded_animation_t actual = run(mode);
+            printf("    {%2u, %4u, 0x%08X},\n", actual.mode, actual.frames, actual.hash);
+        }
+        printf("};\n");
+    }
+    rgblight_set_effect_range(0, RGBLED_NUM);
+}
+#endif
+
+TEST_F(RgblightAnimations, FullStripMatchesRecording) {
+    rgblight_set_effect_range(0, RGBLED_NUM);
+    expect_recorded(recorded_full, sizeof(recorded_full) / sizeof(recorded_full[0]));
+}
+
+TEST_F(RgblightAnimations, EffectRangeMatchesRecording) {
+    rgblight_set_effect_range(2, RGBLED_NUM - 4);
+    expect_recorded(recorded_range, sizeof(recorded_range) / sizeof(recorded_range[0]));
+    rgblight_set_effect_range(0, RGBLED_NUM);
+}
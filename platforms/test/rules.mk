@@ -23,3 +23,80 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+BUDGET_PATH := $(PLATFORM_PATH)/$(PLATFORM_KEY)/budget
+
+# every basic block executed is counted, see budget_common.cpp
+BUDGET_COMMON_DEFS := -DEEPROM_TEST_HARNESS -fsanitize-coverage=trace-pc
+BUDGET_COMMON_INC := $(BUDGET_PATH)
+BUDGET_COMMON_SRC := \
+	$(BUDGET_PATH)/budget_common.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+BUDGET_DEBOUNCE_DEFS := $(BUDGET_COMMON_DEFS) -DMATRIX_ROWS=24 -DMATRIX_COLS=32 -DDEBOUNCE=5
+BUDGET_DEBOUNCE_SRC := $(BUDGET_COMMON_SRC) \
+	$(BUDGET_PATH)/debounce_budget_tests.cpp
+
+define BUDGET_DEBOUNCE_TEST
+budget_debounce_$1_DEFS := $$(BUDGET_DEBOUNCE_DEFS)
+budget_debounce_$1_INC := $$(BUDGET_COMMON_INC)
+budget_debounce_$1_SRC := $$(BUDGET_DEBOUNCE_SRC) \
+	$$(QUANTUM_PATH)/debounce/$1.c
+endef
+
+$(foreach ALGORITHM,none sym_defer_g sym_defer_pk sym_defer_pr sym_eager_pk sym_eager_pr asym_eager_defer_pk,$(eval $(call BUDGET_DEBOUNCE_TEST,$(ALGORITHM))))
+
+budget_action_layer_DEFS := $(BUDGET_COMMON_DEFS) -DMATRIX_ROWS=24 -DMATRIX_COLS=32 -DLAYER_STATE_32BIT
+budget_action_layer_INC := $(BUDGET_COMMON_INC)
+budget_action_layer_SRC := $(BUDGET_COMMON_SRC) \
+	$(QUANTUM_PATH)/action_layer.c \
+	$(QUANTUM_PATH)/logging/debug.c \
+	$(BUDGET_PATH)/action_layer_budget_tests.cpp
+
+budget_report_DEFS := $(BUDGET_COMMON_DEFS) -DNKRO_ENABLE
+budget_report_INC := $(BUDGET_COMMON_INC)
+budget_report_SRC := $(BUDGET_COMMON_SRC) \
+	$(TMK_PATH)/protocol/report.c \
+	$(QUANTUM_PATH)/bitwise.c \
+	$(QUANTUM_PATH)/logging/debug.c \
+	$(BUDGET_PATH)/report_budget_tests.cpp
+
+ws2812_framebuffer_DEFS := -DEEPROM_TEST_HARNESS -DNO_PRINT -DNO_DEBUG -DMATRIX_ROWS=1 -DMATRIX_COLS=1 \
+	-DRGBLIGHT_ENABLE -DRGBLIGHT_WS2812 -DRGBLED_NUM=4 -DRGBLIGHT_EFFECT_BREATHING \
+	-DRGB_MATRIX_ENABLE -DRGB_MATRIX_WS2812 -DRGB_MATRIX_LED_COUNT=6 -DWS2812_SHARED_FRAMEBUFFER
+ws2812_framebuffer_INC := \
+	$(QUANTUM_PATH)/rgblight \
+	$(QUANTUM_PATH)/rgb_matrix \
+	$(QUANTUM_PATH)/rgb_matrix/animations \
+	$(TOP_DIR)/drivers
+ws2812_framebuffer_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/ws2812_framebuffer_tests.cpp \
+	$(QUANTUM_PATH)/ws2812_framebuffer.c \
+	$(QUANTUM_PATH)/rgblight/rgblight.c \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix_drivers.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/led_tables.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(LIB_PATH)/lib8tion/lib8tion.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+rgblight_animations_DEFS := -DEEPROM_TEST_HARNESS -DNO_PRINT -DNO_DEBUG -DMATRIX_ROWS=1 -DMATRIX_COLS=1 \
+	-DRGBLIGHT_ENABLE -DRGBLIGHT_WS2812 -DRGBLED_NUM=10 \
+	-DRGBLIGHT_EFFECT_BREATHING -DRGBLIGHT_EFFECT_RAINBOW_MOOD -DRGBLIGHT_EFFECT_RAINBOW_SWIRL \
+	-DRGBLIGHT_EFFECT_SNAKE -DRGBLIGHT_EFFECT_KNIGHT -DRGBLIGHT_EFFECT_CHRISTMAS \
+	-DRGBLIGHT_EFFECT_STATIC_GRADIENT -DRGBLIGHT_EFFECT_RGB_TEST -DRGBLIGHT_EFFECT_ALTERNATING \
+	-DRGBLIGHT_EFFECT_TWINKLE
+rgblight_animations_INC := \
+	$(QUANTUM_PATH)/rgblight \
+	$(TOP_DIR)/drivers
+rgblight_animations_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/rgblight_animations_tests.cpp \
+	$(QUANTUM_PATH)/rgblight/rgblight.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/led_tables.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(LIB_PATH)/lib8tion/lib8tion.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
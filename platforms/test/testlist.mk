@@ -1 +1,12 @@
 TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += ws2812_framebuffer rgblight_animations
+TEST_LIST += \
+	budget_debounce_none \
+	budget_debounce_sym_defer_g \
+	budget_debounce_sym_defer_pk \
+	budget_debounce_sym_defer_pr \
+	budget_debounce_sym_eager_pk \
+	budget_debounce_sym_eager_pr \
+	budget_debounce_asym_eager_defer_pk \
+	budget_action_layer \
+	budget_report
@@ -0,0 +1,103 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+// the config structs of rgblight and RGB Matrix are checked with C11 asserts
+#define _Static_assert static_assert
+
+extern "C" {
+#include "ws2812_framebuffer.h"
+#include "rgblight.h"
+#include "rgb_matrix.h"
+#include "eeconfig.h"
+
+void advance_time(uint32_t ms);
+
+// The chain as last sent to the LEDs
+static std::vector<rgb_led_t> sent_chain;
+static uint32_t               sent_count = 0;
+
+void ws2812_setleds(rgb_led_t *ledarray, uint16_t number_of_leds) {
+    sent_chain.assign(ledarray, ledarray + number_of_leds);
+    sent_count++;
+}
+
+bool eeconfig_is_enabled(void) {
+    return true;
+}
+
+void eeconfig_init(void) {}
+}
+
+class Ws2812Framebuffer : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        rgblight_enable_noeeprom();
+        rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+        rgblight_setrgb(0, 0, 0);
+        rgb_matrix_driver.set_color_all(0, 0, 0);
+        rgb_matrix_driver.flush();
+        sent_count = 0;
+    }
+
+    static bool is(const rgb_led_t &led, uint8_t r, uint8_t g, uint8_t b) {
+        return led.r == r && led.g == g && led.b == b;
+    }
+};
+
+TEST_F(Ws2812Framebuffer, BothSubsystemsLandInTheirOwnRegion) {
+    rgb_matrix_driver.set_color(1, 10, 20, 30);
+    rgblight_setrgb_at(40, 50, 60, 2);
+    rgb_matrix_driver.flush();
+
+    ASSERT_EQ(sent_chain.size(), RGB_MATRIX_LED_COUNT + RGBLED_NUM);
+    for (uint16_t i = 0; i < sent_chain.size(); i++) {
+        if (i == WS2812_RGB_MATRIX_OFFSET + 1) {
+            EXPECT_TRUE(is(sent_chain[i], 10, 20, 30)) << "LED " << i;
+        } else if (i == WS2812_RGBLIGHT_OFFSET + 2) {
+            EXPECT_TRUE(is(sent_chain[i], 40, 50, 60)) << "LED " << i;
+        } else {
+            EXPECT_TRUE(is(sent_chain[i], 0, 0, 0)) << "LED " << i;
+        }
+    }
+}
+
+TEST_F(Ws2812Framebuffer, OneFlushPerFrame) {
+    // a frame of RGB Matrix, with the underglow changing in between
+    rgb_matrix_driver.set_color_all(1, 2, 3);
+    rgblight_setrgb(4, 5, 6);
+    EXPECT_EQ(sent_count, 0);
+    rgb_matrix_driver.flush();
+    EXPECT_EQ(sent_count, 1);
+
+    // the underglow change went out with the frame, the task has nothing left to send
+    advance_time(WS2812_FRAMEBUFFER_FLUSH_LIMIT);
+    ws2812_framebuffer_task();
+    EXPECT_EQ(sent_count, 1);
+
+    // an unchanged frame isn't sent again
+    rgb_matrix_driver.set_color_all(1, 2, 3);
+    rgb_matrix_driver.flush();
+    EXPECT_EQ(sent_count, 1);
+}
+
+TEST_F(Ws2812Framebuffer, UnderglowAloneIsSentByTheTask) {
+    advance_time(WS2812_FRAMEBUFFER_FLUSH_LIMIT);
+    rgblight_setrgb(7, 8, 9);
+    rgblight_setrgb(9, 8, 7);
+    EXPECT_EQ(sent_count, 0);
+
+    ws2812_framebuffer_task();
+    EXPECT_EQ(sent_count, 1);
+    EXPECT_TRUE(is(sent_chain[WS2812_RGBLIGHT_OFFSET], 9, 8, 7));
+
+    // at most once every WS2812_FRAMEBUFFER_FLUSH_LIMIT ms
+    rgblight_setrgb(1, 1, 1);
+    ws2812_framebuffer_task();
+    EXPECT_EQ(sent_count, 1);
+    advance_time(WS2812_FRAMEBUFFER_FLUSH_LIMIT);
+    ws2812_framebuffer_task();
+    EXPECT_EQ(sent_count, 2);
+}
@@ -282,36 +282,214 @@ static uint8_t get_mods_for_report(void) {
     return mods;
 }
 
+#ifdef KEYBOARD_REPORT_BATCHING
+typedef enum {
+    REPORT_BATCH_EMPTY,    // nothing waiting to be sent
+    REPORT_BATCH_PRESSES,  // keys and mods were only pressed since the last report sent
+    REPORT_BATCH_RELEASES, // keys and mods were only released since the last report sent
+    REPORT_BATCH_CLOSED,   // anything else, nothing more can be merged into it
+} report_batch_state_t;
+
+typedef struct {
+    report_batch_state_t state;
+    bool                 keys_pressed;
+} report_batch_t;
+
+static bool report_batching = false;
+
+/** \brief Merges a change of the report into the one waiting to be sent
+ *
+ * The host only sees the last state of a batch. This is the same as what it
+ * would have seen from the single reports as long as keys and mods are only
+ * pressed, or only released, and no mod is pressed after a key it could apply to.
+ *
+ * \return false if the report waiting to be sent has to be sent first
+ */
+static bool report_batch_merge(report_batch_t *batch, bool presses, bool releases, bool presses_keys, bool presses_mods) {
+    switch (batch->state) {
+        case REPORT_BATCH_EMPTY:
+            batch->state        = presses ? REPORT_BATCH_PRESSES : releases ? REPORT_BATCH_RELEASES : REPORT_BATCH_CLOSED;
+            batch->keys_pressed = presses_keys;
+            return true;
+        case REPORT_BATCH_PRESSES:
+            // a release, e.g. of a key this batch pressed, sends the presses first so none is lost
+            if (!presses || (presses_mods && batch->keys_pressed)) {
+                return false;
+            }
+            batch->keys_pressed |= presses_keys;
+            return true;
+        case REPORT_BATCH_RELEASES:
+            return releases;
+        default:
+            return false;
+    }
+}
+
+static bool keyboard_report_has_keys(const report_keyboard_t *report, const report_keyboard_t *keys) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keys->keys[i] && memchr(report->keys, keys->keys[i], KEYBOARD_REPORT_KEYS) == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#    ifdef NKRO_ENABLE
+static bool nkro_report_has_keys(const report_nkro_t *report, const report_nkro_t *keys) {
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        if (keys->bits[i] & ~report->bits[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+#    endif
+#endif
+
+#ifndef PROTOCOL_VUSB
+static report_keyboard_t last_keyboard_report;
+#    ifdef KEYBOARD_REPORT_BATCHING
+static report_keyboard_t pending_keyboard_report;
+static report_batch_t    keyboard_report_batch;
+
+static void batch_6kro_report(void) {
+    if (keyboard_report_batch.state == REPORT_BATCH_EMPTY) {
+        memcpy(&pending_keyboard_report, &last_keyboard_report, sizeof(report_keyboard_t));
+    }
+    if (memcmp(keyboard_report, &pending_keyboard_report, sizeof(report_keyboard_t)) == 0) {
+        return;
+    }
+
+    const report_keyboard_t *pending = &pending_keyboard_report;
+    const bool               keys_released = !keyboard_report_has_keys(keyboard_report, pending);
+    const bool               keys_pressed  = !keyboard_report_has_keys(pending, keyboard_report);
+    const bool               mods_released = pending->mods & ~keyboard_report->mods;
+    const bool               mods_pressed  = keyboard_report->mods & ~pending->mods;
+
+    if (!report_batch_merge(&keyboard_report_batch, !keys_released && !mods_released, !keys_pressed && !mods_pressed, keys_pressed, mods_pressed)) {
+        memcpy(&last_keyboard_report, pending, sizeof(report_keyboard_t));
+        host_keyboard_send(&last_keyboard_report);
+        keyboard_report_batch.state = REPORT_BATCH_EMPTY;
+        report_batch_merge(&keyboard_report_batch, !keys_released && !mods_released, !keys_pressed && !mods_pressed, keys_pressed, mods_pressed);
+    }
+    memcpy(&pending_keyboard_report, keyboard_report, sizeof(report_keyboard_t));
+}
+#    endif
+#endif
+
 void send_6kro_report(void) {
     keyboard_report->mods = get_mods_for_report();
 
 #ifdef PROTOCOL_VUSB
     host_keyboard_send(keyboard_report);
 #else
-    static report_keyboard_t last_report;
+#    ifdef KEYBOARD_REPORT_BATCHING
+    if (report_batching) {
+        batch_6kro_report();
+        return;
+    }
+#    endif
 
     /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(keyboard_report, &last_report, sizeof(report_keyboard_t)) != 0) {
-        memcpy(&last_report, keyboard_report, sizeof(report_keyboard_t));
+    if (memcmp(keyboard_report, &last_keyboard_report, sizeof(report_keyboard_t)) != 0) {
+        memcpy(&last_keyboard_report, keyboard_report, sizeof(report_keyboard_t));
         host_keyboard_send(keyboard_report);
     }
 #endif
 }
 
 #ifdef NKRO_ENABLE
+static report_nkro_t last_nkro_report;
+#    ifdef KEYBOARD_REPORT_BATCHING
+static report_nkro_t  pending_nkro_report;
+static report_batch_t nkro_report_batch;
+
+static void batch_nkro_report(void) {
+    if (nkro_report_batch.state == REPORT_BATCH_EMPTY) {
+        memcpy(&pending_nkro_report, &last_nkro_report, sizeof(report_nkro_t));
+    }
+    if (memcmp(nkro_report, &pending_nkro_report, sizeof(report_nkro_t)) == 0) {
+        return;
+    }
+
+    const report_nkro_t *pending       = &pending_nkro_report;
+    const bool           keys_released = !nkro_report_has_keys(nkro_report, pending);
+    const bool           keys_pressed  = !nkro_report_has_keys(pending, nkro_report);
+    const bool           mods_released = pending->mods & ~nkro_report->mods;
+    const bool           mods_pressed  = nkro_report->mods & ~pending->mods;
+
+    if (!report_batch_merge(&nkro_report_batch, !keys_released && !mods_released, !keys_pressed && !mods_pressed, keys_pressed, mods_pressed)) {
+        memcpy(&last_nkro_report, pending, sizeof(report_nkro_t));
+        host_nkro_send(&last_nkro_report);
+        nkro_report_batch.state = REPORT_BATCH_EMPTY;
+        report_batch_merge(&nkro_report_batch, !keys_released && !mods_released, !keys_pressed && !mods_pressed, keys_pressed, mods_pressed);
+    }
+    memcpy(&pending_nkro_report, nkro_report, sizeof(report_nkro_t));
+}
+#    endif
+
 void send_nkro_report(void) {
     nkro_report->mods = get_mods_for_report();
 
-    static report_nkro_t last_report;
+#    ifdef KEYBOARD_REPORT_BATCHING
+    if (report_batching) {
+        batch_nkro_report();
+        return;
+    }
+#    endif
 
     /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(nkro_report, &last_report, sizeof(report_nkro_t)) != 0) {
-        memcpy(&last_report, nkro_report, sizeof(report_nkro_t));
+    if (memcmp(nkro_report, &last_nkro_report, sizeof(report_nkro_t)) != 0) {
+        memcpy(&last_nkro_report, nkro_report, sizeof(report_nkro_t));
         host_nkro_send(nkro_report);
     }
 }
 #endif
 
+#ifdef KEYBOARD_REPORT_BATCHING
+/** \brief Starts collecting keyboard reports instead of sending them
+ *
+ * Until keyboard_report_batch_end() is called, the reports are merged into as
+ * few as possible, see report_batch_merge().
+ */
+void keyboard_report_batch_begin(void) {
+    report_batching = true;
+}
+
+/** \brief Sends the keyboard report still waiting to be sent
+ *
+ * Called by the host before any other kind of report goes out, so the host
+ * sees the keyboard and e.g. consumer or mouse reports in the order they were
+ * made. Batching carries on afterwards.
+ */
+void keyboard_report_batch_send(void) {
+#    ifndef PROTOCOL_VUSB
+    if (keyboard_report_batch.state != REPORT_BATCH_EMPTY) {
+        keyboard_report_batch.state = REPORT_BATCH_EMPTY;
+        if (memcmp(&pending_keyboard_report, &last_keyboard_report, sizeof(report_keyboard_t)) != 0) {
+            memcpy(&last_keyboard_report, &pending_keyboard_report, sizeof(report_keyboard_t));
+            host_keyboard_send(&last_keyboard_report);
+        }
+    }
+#    endif
+#    ifdef NKRO_ENABLE
+    if (nkro_report_batch.state != REPORT_BATCH_EMPTY) {
+        nkro_report_batch.state = REPORT_BATCH_EMPTY;
+        if (memcmp(&pending_nkro_report, &last_nkro_report, sizeof(report_nkro_t)) != 0) {
+            memcpy(&last_nkro_report, &pending_nkro_report, sizeof(report_nkro_t));
+            host_nkro_send(&last_nkro_report);
+        }
+    }
+#    endif
+}
+
+/** \brief Sends the keyboard report still waiting to be sent and stops collecting them */
+void keyboard_report_batch_end(void) {
+    report_batching = false;
+    keyboard_report_batch_send();
+}
+#endif
+
 /** \brief Send keyboard report
  *
  * FIXME: needs doc
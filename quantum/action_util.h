@@ -32,6 +32,14 @@ extern report_nkro_t *nkro_report;
 
 void send_keyboard_report(void);
 
+#ifdef KEYBOARD_REPORT_BATCHING
+void keyboard_report_batch_begin(void);
+void keyboard_report_batch_send(void);
+void keyboard_report_batch_end(void);
+#else
+#    define keyboard_report_batch_send()
+#endif
+
 /* key */
 inline void add_key(uint8_t key) {
     add_key_to_report(key);
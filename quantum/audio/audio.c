@@ -73,7 +73,7 @@ bool playing_note   = false; // or (possibly multiple simultaneous) tones
 bool state_changed  = false; // global flag, which is set if anything changes with the active_tones
 
 // melody/SONG related state variables
-float (*notes_pointer)[][2];                           // SONG, an array of MUSICAL_NOTEs
+musical_note_t (*notes_pointer)[];                     // SONG, an array of MUSICAL_NOTEs
 uint16_t notes_count;                                  // length of the notes_pointer array
 bool     notes_repeat;                                 // PLAY_SONG or PLAY_LOOP?
 uint16_t melody_current_note_duration = 0;             // duration of the currently playing note from the active melody, in ms
@@ -105,9 +105,9 @@ extern uint16_t voices_timer;
 #ifndef AUDIO_OFF_SONG
 #    define AUDIO_OFF_SONG SONG(AUDIO_OFF_SOUND)
 #endif
-float startup_song[][2]   = STARTUP_SONG;
-float audio_on_song[][2]  = AUDIO_ON_SONG;
-float audio_off_song[][2] = AUDIO_OFF_SONG;
+musical_note_t startup_song[]   = STARTUP_SONG;
+musical_note_t audio_on_song[]  = AUDIO_ON_SONG;
+musical_note_t audio_off_song[] = AUDIO_OFF_SONG;
 
 static bool    audio_initialized    = false;
 static bool    audio_driver_stopped = true;
@@ -305,7 +305,7 @@ void audio_play_tone(float pitch) {
     audio_play_note(pitch, 0xffff);
 }
 
-void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
+void audio_play_melody(musical_note_t (*np)[], uint16_t n_count, bool n_repeat) {
     if (!audio_config.enable) {
         audio_stop_all();
         return;
@@ -333,29 +333,25 @@ void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
 
     // start first note manually, which also starts the audio_driver
     // all following/remaining notes are played by 'audio_update_state'
-    audio_play_note((*notes_pointer)[current_note][0], audio_duration_to_ms((*notes_pointer)[current_note][1]));
-    last_timestamp               = timer_read();
-    melody_current_note_duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+    melody_current_note_duration = audio_duration_to_ms(MUSICAL_NOTE_DURATION((*notes_pointer)[current_note]));
+    audio_play_note(MUSICAL_NOTE_PITCH_HZ((*notes_pointer)[current_note]), melody_current_note_duration);
+    last_timestamp = timer_read();
 }
 
-float click[2][2];
-void  audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
+musical_note_t click[2];
+void           audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
     uint16_t duration_tone  = audio_ms_to_duration(duration);
     uint16_t duration_delay = audio_ms_to_duration(delay);
 
     if (delay <= 0.0f) {
-        click[0][0] = pitch;
-        click[0][1] = duration_tone;
-        click[1][0] = 0.0f;
-        click[1][1] = 0.0f;
+        MUSICAL_NOTE_SET(click[0], pitch, duration_tone);
+        MUSICAL_NOTE_SET(click[1], 0.0f, 0);
         audio_play_melody(&click, 1, false);
     } else {
         // first note is a rest/pause
-        click[0][0] = 0.0f;
-        click[0][1] = duration_delay;
+        MUSICAL_NOTE_SET(click[0], 0.0f, duration_delay);
         // second note is the actual click
-        click[1][0] = pitch;
-        click[1][1] = duration_tone;
+        MUSICAL_NOTE_SET(click[1], pitch, duration_tone);
         audio_play_melody(&click, 2, false);
     }
 }
@@ -426,7 +422,7 @@ bool audio_update_state(void) {
                 }
             }
 
-            if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
+            if (!note_resting && MUSICAL_NOTE_PITCH((*notes_pointer)[previous_note]) == MUSICAL_NOTE_PITCH((*notes_pointer)[current_note])) {
                 note_resting = true;
 
                 // special handling for successive notes of the same frequency:
@@ -450,13 +446,13 @@ bool audio_update_state(void) {
 
                 // '- delta': Skip forward in the next note's length if we've over shot
                 //            the last, so the overall length of the song is the same
-                uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                uint16_t duration = audio_duration_to_ms(MUSICAL_NOTE_DURATION((*notes_pointer)[current_note]));
 
                 // Skip forward past any completely missed notes
                 while (delta > duration && current_note < notes_count - 1) {
                     delta -= duration;
                     current_note++;
-                    duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                    duration = audio_duration_to_ms(MUSICAL_NOTE_DURATION((*notes_pointer)[current_note]));
                 }
 
                 if (delta < duration) {
@@ -467,7 +463,7 @@ bool audio_update_state(void) {
                     duration = 1;
                 }
 
-                audio_play_note((*notes_pointer)[current_note][0], duration);
+                audio_play_note(MUSICAL_NOTE_PITCH_HZ((*notes_pointer)[current_note]), duration);
                 melody_current_note_duration = duration;
             }
         }
@@ -24,9 +24,58 @@
 #define SONG(notes...) \
     { notes }
 
+/* A note of a SONG, its pitch and duration in 1/64 beats
+ *
+ * by default both are stored as floats, with AUDIO_COMPACT_SONGS the pitch is
+ * precompiled into fixed-point Hz and the duration into a byte, which takes a
+ * song from eight down to three bytes per note and lets the player step
+ * through it with integer math only. songs then have to be declared as
+ * 'musical_note_t my_song[] = SONG(...);' instead of 'float my_song[][2]'
+ */
+#ifdef AUDIO_COMPACT_SONGS
+#    include <stdint.h>
+#    include "util.h"
+
+#    ifndef AUDIO_PITCH_SCALE
+#        define AUDIO_PITCH_SCALE 8
+// fractions of a Hz the pitch of compact songs is stored in, NOTE_B8 * 8 still fits 16 bit
+#    endif
+
+typedef struct PACKED {
+    uint16_t pitch;    // in 1/AUDIO_PITCH_SCALE Hz
+    uint8_t  duration; // in 1/64 beats
+} musical_note_t;
+
+#    define AUDIO_PITCH(hz) ((uint16_t)((hz) * AUDIO_PITCH_SCALE + 0.5f))
+// longer notes are clamped to the longest a byte holds, both in song initializers and at runtime
+#    define AUDIO_DURATION(dur) ((uint8_t)((dur) > UINT8_MAX ? UINT8_MAX : (dur)))
+#    define MUSICAL_NOTE_HZ(pitch, duration) \
+        { AUDIO_PITCH(pitch), AUDIO_DURATION(duration) }
+#    define MUSICAL_NOTE_PITCH(n) ((n).pitch)
+#    define MUSICAL_NOTE_PITCH_HZ(n) ((float)(n).pitch / AUDIO_PITCH_SCALE)
+#    define MUSICAL_NOTE_DURATION(n) ((n).duration)
+#    define MUSICAL_NOTE_SET(n, hz, dur)        \
+        do {                                    \
+            (n).pitch    = AUDIO_PITCH(hz);     \
+            (n).duration = AUDIO_DURATION(dur); \
+        } while (0)
+#else
+typedef float musical_note_t[2];
+
+#    define MUSICAL_NOTE_HZ(pitch, duration) \
+        { (pitch), duration }
+#    define MUSICAL_NOTE_PITCH(n) ((n)[0])
+#    define MUSICAL_NOTE_PITCH_HZ(n) ((n)[0])
+#    define MUSICAL_NOTE_DURATION(n) ((n)[1])
+#    define MUSICAL_NOTE_SET(n, hz, dur) \
+        do {                             \
+            (n)[0] = (hz);               \
+            (n)[1] = (dur);              \
+        } while (0)
+#endif
+
 // Note Types
-#define MUSICAL_NOTE(note, duration) \
-    { (NOTE##note), duration }
+#define MUSICAL_NOTE(note, duration) MUSICAL_NOTE_HZ(NOTE##note, duration)
 
 #define BREVE_NOTE(note) MUSICAL_NOTE(note, 128)
 #define WHOLE_NOTE(note) MUSICAL_NOTE(note, 64)
@@ -19,84 +19,66 @@
 #include "progmem.h"
 #include "util.h"
 
-RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
+// The index into {v, p, q, t} of the red, green and blue output of each hue
+// region, two bits each. Region 6 is only reached by h = 255 and is laid out
+// like region 0.
+static const uint8_t PROGMEM hsv_region_layout[7] = {
+    0 | 3 << 2 | 1 << 4, // v t p
+    2 | 0 << 2 | 1 << 4, // q v p
+    1 | 0 << 2 | 3 << 4, // p v t
+    1 | 2 << 2 | 0 << 4, // p q v
+    3 | 1 << 2 | 0 << 4, // t p v
+    0 | 1 << 2 | 2 << 4, // v p q
+    0 | 3 << 2 | 1 << 4, // v t p
+};
+
+// Converts a colour whose value has already been through the CIE curve. The
+// region is found without dividing, which is a library call on AVR and
+// Cortex-M0, and the output channels are picked from a table rather than by
+// switching on it.
+static inline RGB hsv_to_rgb_kernel(uint8_t hue, uint8_t sat, uint8_t val) {
     RGB      rgb;
-    uint8_t  region, remainder, p, q, t;
+    uint8_t  channels[4];
+    uint8_t  region, remainder, layout;
     uint16_t h, s, v;
 
-    if (hsv.s == 0) {
-#ifdef USE_CIE1931_CURVE
-        if (use_cie) {
-            rgb.r = rgb.g = rgb.b = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-        } else {
-            rgb.r = hsv.v;
-            rgb.g = hsv.v;
-            rgb.b = hsv.v;
-        }
-#else
-        rgb.r = hsv.v;
-        rgb.g = hsv.v;
-        rgb.b = hsv.v;
-#endif
+    if (sat == 0) {
+        rgb.r = val;
+        rgb.g = val;
+        rgb.b = val;
         return rgb;
     }
 
-    h = hsv.h;
-    s = hsv.s;
-#ifdef USE_CIE1931_CURVE
-    if (use_cie) {
-        v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-    } else {
-        v = hsv.v;
-    }
-#else
-    v = hsv.v;
-#endif
+    s = sat;
+    v = val;
 
-    region    = h * 6 / 255;
-    remainder = (h * 2 - region * 85) * 3;
+    // h * 6 / 255, exact for every hue
+    h         = hue * 6;
+    region    = (h + 1 + (h >> 8)) >> 8;
+    remainder = (hue * 2 - region * 85) * 3;
 
-    p = (v * (255 - s)) >> 8;
-    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
-    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+    channels[0] = v;
+    channels[1] = (v * (255 - s)) >> 8;
+    channels[2] = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    channels[3] = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
 
-    switch (region) {
-        case 6:
-        case 0:
-            rgb.r = v;
-            rgb.g = t;
-            rgb.b = p;
-            break;
-        case 1:
-            rgb.r = q;
-            rgb.g = v;
-            rgb.b = p;
-            break;
-        case 2:
-            rgb.r = p;
-            rgb.g = v;
-            rgb.b = t;
-            break;
-        case 3:
-            rgb.r = p;
-            rgb.g = q;
-            rgb.b = v;
-            break;
-        case 4:
-            rgb.r = t;
-            rgb.g = p;
-            rgb.b = v;
-            break;
-        default:
-            rgb.r = v;
-            rgb.g = p;
-            rgb.b = q;
-            break;
-    }
+    layout = pgm_read_byte(&hsv_region_layout[region]);
+    rgb.r  = channels[layout & 0x03];
+    rgb.g  = channels[(layout >> 2) & 0x03];
+    rgb.b  = channels[layout >> 4];
 
     return rgb;
 }
 
+RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
+#ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        return hsv_to_rgb_kernel(hsv.h, hsv.s, pgm_read_byte(&CIE1931_CURVE[hsv.v]));
+    }
+#endif
+    return hsv_to_rgb_kernel(hsv.h, hsv.s, hsv.v);
+}
+
 RGB hsv_to_rgb(HSV hsv) {
 #ifdef USE_CIE1931_CURVE
     return hsv_to_rgb_impl(hsv, true);
@@ -109,6 +91,22 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+void hsv_to_rgb_buffer(const HSV *hsv, RGB *rgb, uint8_t count) {
+#ifdef USE_CIE1931_CURVE
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb_kernel(hsv[i].h, hsv[i].s, pgm_read_byte(&CIE1931_CURVE[hsv[i].v]));
+    }
+#else
+    hsv_to_rgb_buffer_nocie(hsv, rgb, count);
+#endif
+}
+
+void hsv_to_rgb_buffer_nocie(const HSV *hsv, RGB *rgb, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb_kernel(hsv[i].h, hsv[i].s, hsv[i].v);
+    }
+}
+
 #ifdef RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led) {
     // Determine lowest value in all three colors, put that into
@@ -111,6 +111,9 @@ typedef struct PACKED HSV {
 
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
+// Convert `count` colours at once, same as hsv_to_rgb() and hsv_to_rgb_nocie() for each
+void hsv_to_rgb_buffer(const HSV *hsv, RGB *rgb, uint8_t count);
+void hsv_to_rgb_buffer_nocie(const HSV *hsv, RGB *rgb, uint8_t count);
 #ifdef RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led);
 #endif
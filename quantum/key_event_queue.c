@@ -0,0 +1,79 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_event_queue.h"
+
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+#    include <ch.h>
+#    ifndef KEY_EVENT_QUEUE_SCAN_THREAD_PRIORITY
+#        define KEY_EVENT_QUEUE_SCAN_THREAD_PRIORITY (NORMALPRIO + 1)
+#    endif
+#    ifndef KEY_EVENT_QUEUE_SCAN_THREAD_STACK_SIZE
+#        define KEY_EVENT_QUEUE_SCAN_THREAD_STACK_SIZE 512
+#    endif
+#endif
+
+_Static_assert(KEY_EVENT_QUEUE_SIZE >= 2 && KEY_EVENT_QUEUE_SIZE <= 256 && (KEY_EVENT_QUEUE_SIZE & (KEY_EVENT_QUEUE_SIZE - 1)) == 0, "KEY_EVENT_QUEUE_SIZE must be a power of two between 2 and 256");
+
+static keyevent_t queue[KEY_EVENT_QUEUE_SIZE];
+// whether each event is the first of its scan
+static bool queue_scan_start[KEY_EVENT_QUEUE_SIZE];
+// head is only written by the producer, tail only by the consumer
+static uint8_t queue_head = 0;
+static uint8_t queue_tail = 0;
+// only used by the producer, whether the next event pushed starts a new scan
+static bool scan_starting = true;
+
+bool key_event_queue_push(keyevent_t event) {
+    uint8_t head = queue_head;
+    uint8_t next = (head + 1) & (KEY_EVENT_QUEUE_SIZE - 1);
+    if (next == __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    queue[head]            = event;
+    queue_scan_start[head] = scan_starting;
+    scan_starting          = false;
+    // publish the event only once it is written
+    __atomic_store_n(&queue_head, next, __ATOMIC_RELEASE);
+    return true;
+}
+
+void key_event_queue_start_scan(void) {
+    scan_starting = true;
+}
+
+bool key_event_queue_pop(keyevent_t *event, bool *scan_start) {
+    uint8_t tail = queue_tail;
+    if (tail == __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    *event = queue[tail];
+    if (scan_start) {
+        *scan_start = queue_scan_start[tail];
+    }
+    // hand the slot back only once it is read
+    __atomic_store_n(&queue_tail, (tail + 1) & (KEY_EVENT_QUEUE_SIZE - 1), __ATOMIC_RELEASE);
+    return true;
+}
+
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+// matrix_publish() comes from matrix_common.c, a custom matrix has to provide
+// its own, so that it fails to link rather than never delivering a key
+
+static THD_WORKING_AREA(waKeyEventScanThread, KEY_EVENT_QUEUE_SCAN_THREAD_STACK_SIZE);
+static THD_FUNCTION(KeyEventScanThread, arg) {
+    (void)arg;
+    chRegSetThreadName("key_event_scan");
+
+    while (true) {
+        matrix_scan_events();
+        chThdSleepMilliseconds(KEY_EVENT_QUEUE_SCAN_INTERVAL);
+    }
+}
+#endif
+
+void key_event_queue_init(void) {
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+    chThdCreateStatic(waKeyEventScanThread, sizeof(waKeyEventScanThread), KEY_EVENT_QUEUE_SCAN_THREAD_PRIORITY, KeyEventScanThread, NULL);
+#endif
+}
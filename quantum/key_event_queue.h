@@ -0,0 +1,71 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+
+/* Queue of matrix events between the matrix scan and the action processing.
+ *
+ * The scan pushes an event for each key that changed, stamped with the time
+ * of the scan, and matrix_task() processes them in the main loop. The queue is
+ * lock-free with a single producer and a single consumer, so the scan can run
+ * in its own thread with KEY_EVENT_QUEUE_SCAN_THREAD while a slow
+ * process_record_user() or SEND_STRING() blocks the main loop.
+ */
+
+#ifndef KEY_EVENT_QUEUE_SIZE
+// must be a power of two, one slot stays empty
+#    define KEY_EVENT_QUEUE_SIZE 32
+#endif
+
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+#    if !defined(PROTOCOL_CHIBIOS)
+#        error "KEY_EVENT_QUEUE_SCAN_THREAD is only supported on ChibiOS"
+#    endif
+#    if defined(SPLIT_KEYBOARD)
+#        error "KEY_EVENT_QUEUE_SCAN_THREAD is not supported on split keyboards, the scan talks to the other half"
+#    endif
+#    ifndef KEY_EVENT_QUEUE_SCAN_INTERVAL
+// time between two scans of the thread, in ms
+#        define KEY_EVENT_QUEUE_SCAN_INTERVAL 1
+#    endif
+#endif
+
+/**
+ * @brief Adds an event at the end of the queue. Only called by the producer.
+ *
+ * @return false if the queue is full
+ */
+bool key_event_queue_push(keyevent_t event);
+
+/**
+ * @brief Marks the start of a scan, the next event pushed is its first.
+ * Only called by the producer.
+ */
+void key_event_queue_start_scan(void);
+
+/**
+ * @brief Takes the oldest event off the queue. Only called by the consumer.
+ *
+ * @param scan_start set to whether the event is the first of its scan, may be NULL
+ * @return false if the queue is empty
+ */
+bool key_event_queue_pop(keyevent_t *event, bool *scan_start);
+
+/**
+ * @brief Scans the matrix and queues an event for each key that changed.
+ *
+ * This is the producer of the queue. It is called by matrix_task(), or by the
+ * scan thread if KEY_EVENT_QUEUE_SCAN_THREAD is defined.
+ *
+ * @return true if an event was queued
+ */
+bool matrix_scan_events(void);
+
+/**
+ * @brief Starts the scan thread, if KEY_EVENT_QUEUE_SCAN_THREAD is defined.
+ */
+void key_event_queue_init(void);
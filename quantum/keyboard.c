@@ -33,6 +33,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "action_util.h"
+#ifdef KEY_EVENT_QUEUE_ENABLE
+#    include "key_event_queue.h"
+#endif
 #ifdef AUDIO_ENABLE
 #    include "audio.h"
 #endif
@@ -57,6 +61,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef RGB_MATRIX_ENABLE
 #    include "rgb_matrix.h"
 #endif
+#ifdef WS2812_SHARED_FRAMEBUFFER
+#    include "ws2812_framebuffer.h"
+#endif
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif
@@ -187,20 +194,35 @@ void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timesta
 // Only enable this if console is enabled to print to
 #if defined(DEBUG_MATRIX_SCAN_RATE)
 static uint32_t matrix_timer           = 0;
-static uint32_t matrix_scan_count      = 0;
 static uint32_t last_matrix_scan_count = 0;
+#    ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+// only written by the scan thread, which doesn't print, the main loop reports it
+static volatile uint32_t matrix_scan_count = 0;
+#        define matrix_scan_perf_count() matrix_scan_count++
+#    else
+static uint32_t matrix_scan_count = 0;
+#    endif
 
 void matrix_scan_perf_task(void) {
-    matrix_scan_count++;
+#    ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+    static uint32_t matrix_scan_count_start = 0;
+    uint32_t        count                   = matrix_scan_count - matrix_scan_count_start;
+#    else
+    uint32_t count = ++matrix_scan_count;
+#    endif
 
     uint32_t timer_now = timer_read32();
     if (TIMER_DIFF_32(timer_now, matrix_timer) >= 1000) {
 #    if defined(CONSOLE_ENABLE)
-        dprintf("matrix scan frequency: %lu\n", matrix_scan_count);
+        dprintf("matrix scan frequency: %lu\n", count);
 #    endif
-        last_matrix_scan_count = matrix_scan_count;
+        last_matrix_scan_count = count;
         matrix_timer           = timer_now;
-        matrix_scan_count      = 0;
+#    ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+        matrix_scan_count_start += count;
+#    else
+        matrix_scan_count = 0;
+#    endif
     }
 }
 
@@ -209,6 +231,7 @@ uint32_t get_matrix_scan_rate(void) {
 }
 #else
 #    define matrix_scan_perf_task()
+#    define matrix_scan_perf_count()
 #endif
 
 #ifdef MATRIX_HAS_GHOST
@@ -412,6 +435,10 @@ void keyboard_init(void) {
 #endif
     matrix_init();
     quantum_init();
+#ifdef KEY_EVENT_QUEUE_ENABLE
+    // bootmagic scans the matrix itself in quantum_init(), so the scan thread starts after it
+    key_event_queue_init();
+#endif
 #if defined(CRC_ENABLE)
     crc_init();
 #endif
@@ -494,6 +521,111 @@ static inline void generate_tick_event(void) {
     }
 }
 
+#ifdef KEY_EVENT_QUEUE_ENABLE
+bool matrix_scan_events(void) {
+    if (!matrix_can_read()) {
+        return false;
+    }
+
+    static matrix_row_t matrix_previous[MATRIX_ROWS];
+
+    matrix_scan();
+#    ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+    // only this thread writes the published state, the rows below are consistent
+    matrix_publish();
+    matrix_scan_perf_count();
+#    else
+    matrix_scan_perf_task();
+#    endif
+
+    key_event_queue_start_scan();
+    bool queued = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        const matrix_row_t current_row = matrix_get_row(row);
+        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+
+        if (!row_changes || has_ghost_in_row(row, current_row)) {
+            continue;
+        }
+
+        matrix_row_t col_mask = 1;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
+            if (row_changes & col_mask) {
+                // The event carries the time of this scan, however late it is processed
+                if (!key_event_queue_push(MAKE_KEYEVENT(row, col, current_row & col_mask))) {
+                    // queue full, the remaining changes are picked up by the next scan
+                    return queued;
+                }
+                matrix_previous[row] ^= col_mask;
+                queued = true;
+            }
+        }
+    }
+    return queued;
+}
+
+/**
+ * @brief This task processes the key presses queued by the matrix scan.
+ *
+ * @return true Matrix did change
+ * @return false Matrix didn't change
+ */
+static bool matrix_task(void) {
+#    ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+    matrix_scan_perf_task();
+#    else
+    matrix_scan_events();
+#    endif
+
+    keyevent_t event;
+    bool       scan_start;
+    if (!key_event_queue_pop(&event, &scan_start)) {
+#    ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+        matrix_scan_kb();
+#    endif
+        generate_tick_event();
+        return false;
+    }
+
+    if (debug_config.matrix) {
+        matrix_print();
+    }
+
+    const bool process_keypress = should_process_keypress();
+
+#    ifdef KEYBOARD_REPORT_BATCHING
+    // the changes of each scan go to the host in as few reports as possible
+    keyboard_report_batch_begin();
+#    endif
+
+    do {
+#    ifdef KEYBOARD_REPORT_BATCHING
+        if (scan_start) {
+            // merging the changes of several scans would lose the order they were typed in
+            keyboard_report_batch_end();
+            keyboard_report_batch_begin();
+        }
+#    endif
+
+        if (process_keypress) {
+            action_exec(event);
+        }
+
+        switch_events(event.key.row, event.key.col, event.pressed);
+    } while (key_event_queue_pop(&event, &scan_start));
+
+#    ifdef KEYBOARD_REPORT_BATCHING
+    keyboard_report_batch_end();
+#    endif
+
+#    ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+    // the keyboard and user scan hooks stay on the main loop, they aren't thread safe
+    matrix_scan_kb();
+#    endif
+
+    return true;
+}
+#else
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -529,6 +661,11 @@ static bool matrix_task(void) {
 
     const bool process_keypress = should_process_keypress();
 
+#ifdef KEYBOARD_REPORT_BATCHING
+    // all changes of this scan go to the host in as few reports as possible
+    keyboard_report_batch_begin();
+#endif
+
     for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
         const matrix_row_t current_row = matrix_get_row(row);
         const matrix_row_t row_changes = current_row ^ matrix_previous[row];
@@ -553,8 +690,13 @@ static bool matrix_task(void) {
         matrix_previous[row] = current_row;
     }
 
+#ifdef KEYBOARD_REPORT_BATCHING
+    keyboard_report_batch_end();
+#endif
+
     return matrix_changed;
 }
+#endif
 
 /** \brief Tasks previously located in matrix_scan_quantum
  *
@@ -655,6 +797,9 @@ void keyboard_task(void) {
 #ifdef RGB_MATRIX_ENABLE
     rgb_matrix_task();
 #endif
+#ifdef WS2812_SHARED_FRAMEBUFFER
+    ws2812_framebuffer_task();
+#endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
@@ -717,5 +862,9 @@ void keyboard_task(void) {
     haptic_task();
 #endif
 
+#if defined(EEPROM_WEAR_LEVELING) && (defined(WEAR_LEVELING_WRITE_BACK) || defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION))
+    eeprom_driver_task();
+#endif
+
     led_task();
 }
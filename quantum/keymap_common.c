@@ -48,7 +48,7 @@ action_t action_for_key(uint8_t layer, keypos_t key) {
     return action_for_keycode(keycode);
 };
 
-action_t action_for_keycode(uint16_t keycode) {
+static action_t resolve_action_for_keycode(uint16_t keycode) {
     // keycode remapping
     keycode = keycode_config(keycode);
 
@@ -192,6 +192,45 @@ action_t action_for_keycode(uint16_t keycode) {
     return action;
 }
 
+#ifdef ACTION_CACHE_SIZE
+_Static_assert(ACTION_CACHE_SIZE > 0 && (ACTION_CACHE_SIZE & (ACTION_CACHE_SIZE - 1)) == 0, "ACTION_CACHE_SIZE must be a power of two");
+
+// Direct-mapped cache of resolved actions. The resolution depends only on the
+// keycode and keymap_config, so the cache is flushed whenever keymap_config changes.
+typedef struct {
+    uint16_t keycode;
+    action_t action;
+} action_cache_entry_t;
+
+static action_cache_entry_t action_cache[ACTION_CACHE_SIZE];
+static uint16_t             action_cache_config;
+static bool                 action_cache_valid = false;
+
+action_t action_for_keycode(uint16_t keycode) {
+    if (!action_cache_valid || action_cache_config != keymap_config.raw) {
+        // KC_NO maps to the first slot only, so for every other slot it can't hit
+        action_cache_entry_t empty = {KC_NO, resolve_action_for_keycode(KC_NO)};
+        for (uint16_t i = 0; i < ACTION_CACHE_SIZE; i++) {
+            action_cache[i] = empty;
+        }
+        action_cache_config = keymap_config.raw;
+        action_cache_valid  = true;
+    }
+
+    // fold in the high byte, so e.g. LT(1, KC_A) and KC_A don't share a slot
+    action_cache_entry_t *entry = &action_cache[(keycode ^ (keycode >> 8)) & (ACTION_CACHE_SIZE - 1)];
+    if (entry->keycode != keycode) {
+        entry->keycode = keycode;
+        entry->action  = resolve_action_for_keycode(keycode);
+    }
+    return entry->action;
+}
+#else
+action_t action_for_keycode(uint16_t keycode) {
+    return resolve_action_for_keycode(keycode);
+}
+#endif
+
 // translates key to keycode
 __attribute__((weak)) uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
     if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
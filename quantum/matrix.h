@@ -75,6 +75,11 @@ void matrix_scan_kb(void);
 void matrix_init_user(void);
 void matrix_scan_user(void);
 
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+/* copy the state of the last scan to what the main loop reads */
+void matrix_publish(void);
+#endif
+
 #ifdef SPLIT_KEYBOARD
 bool matrix_post_scan(void);
 void matrix_slave_scan_kb(void);
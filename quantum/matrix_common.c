@@ -31,6 +31,24 @@ uint8_t thisHand, thatHand;
 extern const matrix_row_t matrix_mask[];
 #endif
 
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+#    include <ch.h>
+#    include <string.h>
+
+// The scan thread debounces into matrix[] while the main loop reads the
+// state, so everyone reads the copy of the last complete scan instead.
+static matrix_row_t matrix_published[MATRIX_ROWS];
+#    define matrix_state matrix_published
+
+void matrix_publish(void) {
+    chSysLock();
+    memcpy(matrix_published, matrix, sizeof(matrix_published));
+    chSysUnlock();
+}
+#else
+#    define matrix_state matrix
+#endif
+
 // user-defined overridable functions
 
 __attribute__((weak)) void matrix_init_kb(void) {
@@ -56,16 +74,16 @@ inline uint8_t matrix_cols(void) {
 }
 
 inline bool matrix_is_on(uint8_t row, uint8_t col) {
-    return (matrix[row] & ((matrix_row_t)1 << col));
+    return (matrix_state[row] & ((matrix_row_t)1 << col));
 }
 
 inline matrix_row_t matrix_get_row(uint8_t row) {
     // Matrix mask lets you disable switches in the returned matrix data. For example, if you have a
     // switch blocker installed and the switch is always pressed.
 #ifdef MATRIX_MASKED
-    return matrix[row] & matrix_mask[row];
+    return matrix_state[row] & matrix_mask[row];
 #else
-    return matrix[row];
+    return matrix_state[row];
 #endif
 }
 
@@ -172,12 +190,15 @@ __attribute__((weak)) uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifndef KEY_EVENT_QUEUE_SCAN_THREAD
+    // with the scan thread, matrix_task() runs this in the main loop instead
     matrix_scan_kb();
+#    endif
 #endif
 
     return changed;
 }
 
 __attribute__((weak)) bool peek_matrix(uint8_t row_index, uint8_t col_index, bool raw) {
-    return 0 != ((raw ? raw_matrix[row_index] : matrix[row_index]) & (MATRIX_ROW_SHIFTER << col_index));
+    return 0 != ((raw ? raw_matrix[row_index] : matrix_state[row_index]) & (MATRIX_ROW_SHIFTER << col_index));
 }
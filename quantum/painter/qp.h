@@ -88,6 +88,15 @@
 #    define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_PALETTE_CACHE_SIZE
+/**
+ * @def This controls the number of recolored palettes that are kept in their native pixel format. Drawing fonts or
+ *      images with a handful of different fg/bg color pairs reuses the converted palettes instead of regenerating them
+ *      on each draw. Each entry requires 80 bytes of RAM. Set to 0 to disable the cache.
+ */
+#    define QUANTUM_PAINTER_PALETTE_CACHE_SIZE 4
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter types
 
@@ -48,6 +48,11 @@ extern qp_pixel_t qp_internal_global_pixel_lookup_table[16];
 // As this uses a global, this may present a problem if using the same parameters but a different screen converts pixels -- use qp_internal_invalidate_palette() below to reset.
 bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps);
 
+// Generates a color-interpolated lookup table as per qp_internal_interpolate_palette(), and converts it to the native pixel format of the device.
+// Recently converted palettes are cached (see QUANTUM_PAINTER_PALETTE_CACHE_SIZE), so alternating between color pairs does not regenerate them.
+// Returns false if the conversion failed.
+bool qp_internal_interpolate_and_convert_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps);
+
 // Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
 void qp_internal_invalidate_palette(void);
 
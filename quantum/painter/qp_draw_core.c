@@ -33,6 +33,26 @@ __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table
 __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table[16];
 #endif
 
+// Driver whose native pixel format the global palette has been converted to, if any
+static const painter_driver_vtable_t *converted_vtable = NULL;
+static uint8_t                        converted_bpp    = 0;
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+// Cache of previously converted palettes, keyed by the recolor parameters and the native pixel format of the device.
+// Only palettes of up to 16 entries are cached, larger palettes are regenerated on demand.
+typedef struct qp_palette_cache_entry_t {
+    const painter_driver_vtable_t *driver_vtable;
+    uint8_t                        native_bits_per_pixel;
+    int16_t                        steps;
+    qp_pixel_t                     fg_hsv888;
+    qp_pixel_t                     bg_hsv888;
+    qp_pixel_t                     palette[16];
+} qp_palette_cache_entry_t;
+
+__attribute__((__aligned__(4))) static qp_palette_cache_entry_t palette_cache[QUANTUM_PAINTER_PALETTE_CACHE_SIZE];
+static uint8_t                                                  palette_cache_next_victim = 0;
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helpers
 
@@ -68,13 +88,20 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
 void qp_internal_invalidate_palette(void) {
     generated_palette = false;
     generated_steps   = -1;
+    converted_vtable  = NULL;
+    converted_bpp     = 0;
+}
+
+// Checks whether the global palette was generated using the supplied parameters
+static inline bool qp_internal_palette_params_match(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
+    return generated_palette == true && generated_steps == steps && memcmp(&interpolated_fg_hsv888, &fg_hsv888, sizeof(fg_hsv888)) == 0 && memcmp(&interpolated_bg_hsv888, &bg_hsv888, sizeof(bg_hsv888)) == 0;
 }
 
 // Interpolates between two colors to generate a palette
 bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
     // Check if we need to generate a new palette -- if the input parameters match then assume the palette can stay unchanged.
     // This may present a problem if using the same parameters but a different screen converts pixels -- use qp_internal_invalidate_palette() to reset.
-    if (generated_palette == true && generated_steps == steps && memcmp(&interpolated_fg_hsv888, &fg_hsv888, sizeof(fg_hsv888)) == 0 && memcmp(&interpolated_bg_hsv888, &bg_hsv888, sizeof(bg_hsv888)) == 0) {
+    if (qp_internal_palette_params_match(fg_hsv888, bg_hsv888, steps)) {
         // We already have the correct palette, no point regenerating it.
         return false;
     }
@@ -107,6 +134,62 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
     return true;
 }
 
+// Interpolates between two colors and converts the result to the native pixel format of the device, reusing a previously converted palette if possible
+bool qp_internal_interpolate_and_convert_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    // Check if the global palette is already in the correct state
+    if (converted_vtable == driver->driver_vtable && converted_bpp == driver->native_bits_per_pixel && qp_internal_palette_params_match(fg_hsv888, bg_hsv888, steps)) {
+        return true;
+    }
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    const bool cacheable = steps <= (int16_t)(sizeof(palette_cache[0].palette) / sizeof(palette_cache[0].palette[0]));
+    if (cacheable) {
+        for (uint8_t i = 0; i < QUANTUM_PAINTER_PALETTE_CACHE_SIZE; ++i) {
+            qp_palette_cache_entry_t *entry = &palette_cache[i];
+            if (entry->driver_vtable == driver->driver_vtable && entry->native_bits_per_pixel == driver->native_bits_per_pixel && entry->steps == steps && memcmp(&entry->fg_hsv888, &fg_hsv888, sizeof(fg_hsv888)) == 0 && memcmp(&entry->bg_hsv888, &bg_hsv888, sizeof(bg_hsv888)) == 0) {
+                qp_dprintf("qp_internal_interpolate_and_convert_palette: cache hit (slot %d)\n", (int)i);
+                memcpy(qp_internal_global_pixel_lookup_table, entry->palette, steps * sizeof(qp_pixel_t));
+                generated_palette      = true;
+                generated_steps        = steps;
+                interpolated_fg_hsv888 = fg_hsv888;
+                interpolated_bg_hsv888 = bg_hsv888;
+                converted_vtable       = driver->driver_vtable;
+                converted_bpp          = driver->native_bits_per_pixel;
+                return true;
+            }
+        }
+    }
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+
+    // The global palette may hold a palette converted for a different device, so force regeneration
+    qp_internal_invalidate_palette();
+    qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, steps);
+    if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
+        qp_internal_invalidate_palette();
+        return false;
+    }
+    converted_vtable = driver->driver_vtable;
+    converted_bpp    = driver->native_bits_per_pixel;
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    if (cacheable) {
+        qp_palette_cache_entry_t *entry = &palette_cache[palette_cache_next_victim];
+        qp_dprintf("qp_internal_interpolate_and_convert_palette: caching in slot %d\n", (int)palette_cache_next_victim);
+        entry->driver_vtable         = driver->driver_vtable;
+        entry->native_bits_per_pixel = driver->native_bits_per_pixel;
+        entry->steps                 = steps;
+        entry->fg_hsv888             = fg_hsv888;
+        entry->bg_hsv888             = bg_hsv888;
+        memcpy(entry->palette, qp_internal_global_pixel_lookup_table, steps * sizeof(qp_pixel_t));
+        palette_cache_next_victim = (palette_cache_next_victim + 1) % QUANTUM_PAINTER_PALETTE_CACHE_SIZE;
+    }
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+
+    return true;
+}
+
 // Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
 bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
     qgf_palette_v1_t palette_descriptor;
@@ -169,8 +169,12 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         needs_pixconvert = true;
     } else {
         if (info->bpp <= 8) {
-            // Interpolate from fg/bg
-            needs_pixconvert = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
+            // Interpolate from fg/bg, reusing a cached native palette if available
+            if (!qp_internal_interpolate_and_convert_palette(device, fg_hsv888, bg_hsv888, palette_entries)) {
+                qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
+                qp_comms_stop(device);
+                return false;
+            }
         }
     }
 
@@ -196,9 +196,12 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
         offset += sizeof(qgf_palette_v1_t) + (palette_entries * 3);
         needs_pixconvert = true;
     } else {
-        // Interpolate from fg/bg
-        int16_t palette_entries = 1 << qff_font->bpp;
-        needs_pixconvert        = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
+        // Interpolate from fg/bg, reusing a cached native palette if available
+        if (!qp_internal_interpolate_and_convert_palette(device, fg_hsv888, bg_hsv888, palette_entries)) {
+            qp_dprintf("qp_drawtext_recolor: fail (could not convert pixels to native)\n");
+            qp_comms_stop(device);
+            return false;
+        }
     }
 
     if (needs_pixconvert) {
@@ -28,7 +28,7 @@ float clicky_freq = AUDIO_CLICKY_FREQ_DEFAULT;
 float clicky_rand = AUDIO_CLICKY_FREQ_RANDOMNESS;
 
 // the first "note" is an intentional delay; the 2nd and 3rd notes are the "clicky"
-float clicky_song[][2] = {{0.0f, AUDIO_CLICKY_DELAY_DURATION}, {AUDIO_CLICKY_FREQ_DEFAULT, 3}, {AUDIO_CLICKY_FREQ_DEFAULT, 1}}; // 3 and 1 --> durations
+musical_note_t clicky_song[] = {MUSICAL_NOTE_HZ(0.0f, AUDIO_CLICKY_DELAY_DURATION), MUSICAL_NOTE_HZ(AUDIO_CLICKY_FREQ_DEFAULT, 3), MUSICAL_NOTE_HZ(AUDIO_CLICKY_FREQ_DEFAULT, 1)}; // 3 and 1 --> durations
 
 extern audio_config_t audio_config;
 
@@ -41,8 +41,8 @@ void clicky_play(void) {
 #    ifndef NO_MUSIC_MODE
     if (music_activated || midi_activated || !audio_config.enable) return;
 #    endif // !NO_MUSIC_MODE
-    clicky_song[1][0] = 2.0f * clicky_freq * (1.0f + clicky_rand * (((float)rand()) / ((float)(RAND_MAX))));
-    clicky_song[2][0] = clicky_freq * (1.0f + clicky_rand * (((float)rand()) / ((float)(RAND_MAX))));
+    MUSICAL_NOTE_SET(clicky_song[1], 2.0f * clicky_freq * (1.0f + clicky_rand * (((float)rand()) / ((float)(RAND_MAX)))), 3);
+    MUSICAL_NOTE_SET(clicky_song[2], clicky_freq * (1.0f + clicky_rand * (((float)rand()) / ((float)(RAND_MAX)))), 1);
     PLAY_SONG(clicky_song);
 }
 
@@ -68,13 +68,17 @@
 #    include "process_unicode_common.h"
 #endif
 
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_BACK)
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
 #    endif
-float goodbye_song[][2] = GOODBYE_SONG;
+musical_note_t goodbye_song[] = GOODBYE_SONG;
 #    ifdef DEFAULT_LAYER_SONGS
-float default_layer_songs[][16][2] = DEFAULT_LAYER_SONGS;
+musical_note_t default_layer_songs[][16] = DEFAULT_LAYER_SONGS;
 #    endif
 #endif
 
@@ -194,6 +198,10 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_BACK)
+    // Persist any deferred EEPROM writes before the MCU is reset
+    eeprom_driver_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -504,6 +512,9 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_BACK)
+    eeprom_driver_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
@@ -5,14 +5,27 @@ RGB_MATRIX_EFFECT(BREATHING)
 bool BREATHING(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    HSV      hsv  = rgb_matrix_config.hsv;
-    uint16_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 8);
-    hsv.v         = scale8(abs8(sin8(time) - 128) * 2, hsv.v);
-    RGB rgb       = rgb_matrix_hsv_to_rgb(hsv);
+    HSV      hsv    = rgb_matrix_config.hsv;
+    uint16_t time   = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 8);
+    uint8_t  breath = abs8(sin8(time) - 128) * 2;
+#        ifdef RGB_MATRIX_DITHERING
+    // Fade the full color in 8.8 fixed point, so the dimmest steps are dithered rather than jumping between levels
+    RGB      rgb = rgb_matrix_hsv_to_rgb(hsv);
+    uint16_t r   = rgb.r * breath + (rgb.r * breath >> 8);
+    uint16_t g   = rgb.g * breath + (rgb.g * breath >> 8);
+    uint16_t b   = rgb.b * breath + (rgb.b * breath >> 8);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        rgb_matrix_set_color16(i, r, g, b);
+    }
+#        else
+    hsv.v   = scale8(breath, hsv.v);
+    RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
     }
+#        endif
     return rgb_matrix_check_finished_leds(led_max);
 }
 
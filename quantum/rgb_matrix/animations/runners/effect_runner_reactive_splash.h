@@ -3,27 +3,51 @@
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+// Returns the distance at and beyond which a hit of the given age no longer
+// changes an LED, or 0 once it no longer changes any
+typedef uint16_t (*reactive_splash_reach_f)(uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+bool effect_runner_reactive_splash_reach(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    // Scale the hit ticks once per pass, and drop hits that have faded out
+    uint8_t  count = 0;
+    uint8_t  hit[LED_HITS_TO_REMEMBER];
+    uint16_t hit_tick[LED_HITS_TO_REMEMBER];
+    uint16_t hit_reach[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < g_last_hit_tracker.count; j++) {
+        uint16_t tick  = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        uint16_t reach = reach_func ? reach_func(tick) : UINT16_MAX;
+        if (reach == 0) continue;
+        hit[count]       = j;
+        hit_tick[count]  = tick;
+        hit_reach[count] = reach;
+        count++;
+    }
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         HSV hsv = rgb_matrix_config.hsv;
         hsv.v   = 0;
-        for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+        for (uint8_t j = 0; j < count; j++) {
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[hit[j]];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[hit[j]];
+            // The distance is at least the larger axis offset, so most LEDs
+            // out of reach are rejected without the square root
+            if (abs(dx) >= hit_reach[j] || abs(dy) >= hit_reach[j]) continue;
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            if (dist >= hit_reach[j]) continue;
+            hsv = effect_func(hsv, dx, dy, dist, hit_tick[j]);
         }
-        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
-        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        rgb_matrix_queue_hsv(i, hsv);
     }
+    rgb_matrix_send_queued_hsv();
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_reach(start, params, effect_func, NULL);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -35,10 +35,42 @@ const led_point_t k_rgb_matrix_center = {112, 32};
 const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 #endif
 
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+led_polar_t g_led_polar[RGB_MATRIX_LED_COUNT];
+#endif
+
 __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Goes through rgb_matrix_hsv_to_rgb() for each colour, so its overrides (eg. current limits) still apply
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_buffer(const HSV *hsv, RGB *rgb, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+    }
+}
+
+static HSV     rgb_hsv_queue[RGB_MATRIX_HSV_QUEUE_SIZE];
+static uint8_t rgb_hsv_queue_led[RGB_MATRIX_HSV_QUEUE_SIZE];
+static uint8_t rgb_hsv_queued = 0;
+
+void rgb_matrix_send_queued_hsv(void) {
+    RGB rgb[RGB_MATRIX_HSV_QUEUE_SIZE];
+    rgb_matrix_hsv_to_rgb_buffer(rgb_hsv_queue, rgb, rgb_hsv_queued);
+    for (uint8_t i = 0; i < rgb_hsv_queued; i++) {
+        rgb_matrix_set_color(rgb_hsv_queue_led[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    rgb_hsv_queued = 0;
+}
+
+void rgb_matrix_queue_hsv(uint8_t index, HSV hsv) {
+    rgb_hsv_queue[rgb_hsv_queued]     = hsv;
+    rgb_hsv_queue_led[rgb_hsv_queued] = index;
+    if (++rgb_hsv_queued == RGB_MATRIX_HSV_QUEUE_SIZE) {
+        rgb_matrix_send_queued_hsv();
+    }
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -68,6 +100,8 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #endif // RGB_MATRIX_FRAMEBUFFER_EFFECTS
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
+uint8_t    g_last_hit_led[RGB_MATRIX_LED_COUNT];
+_Static_assert(LED_HITS_TO_REMEMBER < LED_HIT_NONE, "LED_HITS_TO_REMEMBER must be less than 255");
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // internals
@@ -79,11 +113,74 @@ static rgb_task_states rgb_task_state    = SYNCING;
 #if RGB_MATRIX_TIMEOUT > 0
 static uint32_t rgb_anykey_timer;
 #endif // RGB_MATRIX_TIMEOUT > 0
+static bool rgb_effect_drawing = false;
+#if defined(RGB_MATRIX_STATIC_FRAME_SKIP) || defined(RGB_MATRIX_COMPOSITOR)
+static bool rgb_frame_kept = false;
+#endif
+#ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+#    define RGB_MATRIX_FRAME_HASH_INIT 5381
+static bool         rgb_frame_overlaid = false;
+static rgb_config_t rgb_last_config;
+static uint32_t     rgb_frame_hash        = RGB_MATRIX_FRAME_HASH_INIT; // writes to the driver since the last flush
+static uint32_t     rgb_flushed_hash      = 0;                          // writes to the driver before the last flush
+static uint32_t     rgb_overlay_hash      = RGB_MATRIX_FRAME_HASH_INIT; // writes from outside the effect this frame
+static uint32_t     rgb_last_overlay_hash = RGB_MATRIX_FRAME_HASH_INIT; // writes from outside the effect last frame
+#endif // RGB_MATRIX_STATIC_FRAME_SKIP
+
+// Writes made here are hashed directly, so they skip the wrapper in rgb_matrix_drivers.c
+#if defined(RGB_MATRIX_STATIC_FRAME_SKIP) && !defined(RGB_MATRIX_CUSTOM)
+#    define rgb_matrix_output rgb_matrix_untracked_driver
+#else
+#    define rgb_matrix_output rgb_matrix_driver
+#endif
+
+// compositor layers, each bitmap holds one bit per LED
+#ifdef RGB_MATRIX_COMPOSITOR
+#    define RGB_MATRIX_LED_BITMAP_SIZE ((RGB_MATRIX_LED_COUNT + 7) / 8)
+static RGB                  rgb_layer_base[RGB_MATRIX_LED_COUNT];
+static rgb_matrix_overlay_t rgb_layer_overlay[RGB_MATRIX_LED_COUNT];
+static uint8_t              rgb_layer_dirty[RGB_MATRIX_LED_BITMAP_SIZE];
+static uint8_t              rgb_overlay_drawn[RGB_MATRIX_LED_BITMAP_SIZE];
+static uint8_t              rgb_overlay_last_drawn[RGB_MATRIX_LED_BITMAP_SIZE];
+#    if RGB_MATRIX_COMPOSITOR_BASE_INTERVAL > 0
+static uint32_t rgb_base_timer;
+#    endif
+#endif // RGB_MATRIX_COMPOSITOR
+
+// adaptive budget, the LEDs drawn per render step and the time between frames
+// are adjusted at the start of each frame from the time measured for the last
+#ifdef RGB_MATRIX_ADAPTIVE_BUDGET
+#    if RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+static uint8_t rgb_process_limit = RGB_MATRIX_LED_PROCESS_LIMIT;
+#    else
+static uint8_t rgb_process_limit = RGB_MATRIX_LED_COUNT;
+#    endif
+static uint16_t rgb_flush_limit  = RGB_MATRIX_LED_FLUSH_LIMIT;
+static uint16_t rgb_step_time    = 0; // estimated time of a render step, in microseconds
+static uint16_t rgb_frame_time   = 0; // estimated time of all render steps and the flush of a frame, in microseconds
+static uint16_t rgb_render_ms    = 0;
+static uint16_t rgb_flush_ms     = 0;
+static uint8_t  rgb_render_steps = 0;
+static uint32_t rgb_key_timer;
+#    define RGB_MATRIX_FLUSH_INTERVAL rgb_flush_limit
+#else
+#    define RGB_MATRIX_FLUSH_INTERVAL RGB_MATRIX_LED_FLUSH_LIMIT
+#endif // RGB_MATRIX_ADAPTIVE_BUDGET
+
+// dithering, the 8.8 fixed point frame and the fraction each channel carries over between frames
+#ifdef RGB_MATRIX_DITHERING
+#    define RGB_MATRIX_DITHER_MAX 0xFF00
+static uint16_t rgb_dither_frame[RGB_MATRIX_LED_COUNT * 3];
+static uint8_t  rgb_dither_error[RGB_MATRIX_LED_COUNT * 3];
+#endif // RGB_MATRIX_DITHERING
 
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 static last_hit_t last_hit_buffer;
+#    ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+static uint32_t last_hit_time[LED_HITS_TO_REMEMBER]; // synced timer when each hit happened
+#    endif
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // split rgb matrix
@@ -142,23 +239,273 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+static uint32_t rgb_matrix_hash_color(uint32_t hash, int index, uint8_t red, uint8_t green, uint8_t blue) {
+    uint8_t data[4] = {index, red, green, blue};
+    for (uint8_t i = 0; i < 4; i++) {
+        hash = ((hash << 5) + hash) ^ data[i];
+    }
+    return hash;
+}
+
+// Anything drawn over the effect (eg. indicators), the effect is redrawn under it when this changes
+static void rgb_matrix_overlay_written(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (!rgb_effect_drawing) {
+        rgb_overlay_hash = rgb_matrix_hash_color(rgb_overlay_hash, index, red, green, blue);
+    }
+}
+
+void rgb_matrix_driver_written(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_frame_hash = rgb_matrix_hash_color(rgb_frame_hash, index, red, green, blue);
+    rgb_matrix_overlay_written(index, red, green, blue);
+}
+#endif // RGB_MATRIX_STATIC_FRAME_SKIP
+
+static void rgb_matrix_output_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+    rgb_frame_hash = rgb_matrix_hash_color(rgb_frame_hash, index, red, green, blue);
+#endif // RGB_MATRIX_STATIC_FRAME_SKIP
+    rgb_matrix_output.set_color(index, red, green, blue);
+}
+
+#ifdef RGB_MATRIX_COMPOSITOR
+static uint8_t rgb_matrix_blend_channel(uint8_t under, uint8_t over, uint8_t alpha, uint8_t blend) {
+    switch (blend) {
+        case RGB_MATRIX_BLEND_ADD:
+            return qadd8(under, scale8(over, alpha));
+        case RGB_MATRIX_BLEND_MULTIPLY:
+            return blend8(under, scale8(under, over), alpha);
+        default:
+            return alpha == 255 ? over : blend8(under, over, alpha);
+    }
+}
+
+static void rgb_matrix_set_base(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    RGB *pixel = &rgb_layer_base[index];
+    if (pixel->r == red && pixel->g == green && pixel->b == blue) {
+        return;
+    }
+    pixel->r = red;
+    pixel->g = green;
+    pixel->b = blue;
+    rgb_layer_dirty[index / 8] |= 1 << (index % 8);
+}
+
+static void rgb_matrix_set_overlay(int index, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha, rgb_matrix_blend_t blend) {
+    rgb_matrix_overlay_t *pixel = &rgb_layer_overlay[index];
+    uint8_t               mask  = 1 << (index % 8);
+
+    // Redrawing the same overlay as last frame leaves the LED as it is
+    bool drawn = (rgb_overlay_drawn[index / 8] | rgb_overlay_last_drawn[index / 8]) & mask;
+    if (!drawn || pixel->r != red || pixel->g != green || pixel->b != blue || pixel->alpha != alpha || pixel->blend != blend) {
+        *pixel = (rgb_matrix_overlay_t){red, green, blue, alpha, blend};
+        rgb_layer_dirty[index / 8] |= mask;
+    }
+    rgb_overlay_drawn[index / 8] |= mask;
+}
+
+// Starts a new frame of overlays; anything not drawn again before the next
+// compose reveals the base layer
+static void rgb_matrix_overlay_start(void) {
+    memcpy(rgb_overlay_last_drawn, rgb_overlay_drawn, RGB_MATRIX_LED_BITMAP_SIZE);
+    memset(rgb_overlay_drawn, 0, RGB_MATRIX_LED_BITMAP_SIZE);
+}
+
+// Sends the LEDs whose base or overlay changed since the last compose to the driver
+static void rgb_matrix_compose(void) {
+    for (uint8_t byte = 0; byte < RGB_MATRIX_LED_BITMAP_SIZE; byte++) {
+        uint8_t changed = rgb_layer_dirty[byte] | (rgb_overlay_last_drawn[byte] & ~rgb_overlay_drawn[byte]);
+        if (!changed) continue;
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            uint8_t i = byte * 8 + bit;
+            if (!(changed & (1 << bit)) || i >= RGB_MATRIX_LED_COUNT) continue;
+
+            RGB out = rgb_layer_base[i];
+            if (rgb_overlay_drawn[byte] & (1 << bit)) {
+                rgb_matrix_overlay_t *over = &rgb_layer_overlay[i];
+                out.r                      = rgb_matrix_blend_channel(out.r, over->r, over->alpha, over->blend);
+                out.g                      = rgb_matrix_blend_channel(out.g, over->g, over->alpha, over->blend);
+                out.b                      = rgb_matrix_blend_channel(out.b, over->b, over->alpha, over->blend);
+            }
+            rgb_matrix_output_color(i, out.r, out.g, out.b);
+        }
+
+        rgb_layer_dirty[byte]        = 0;
+        rgb_overlay_last_drawn[byte] = rgb_overlay_drawn[byte];
+    }
+}
+
+void rgb_matrix_set_color_blend(int index, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha, rgb_matrix_blend_t blend) {
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) return;
+
+    if (rgb_effect_drawing) {
+        // Effects blend straight onto what they have drawn so far
+        RGB *pixel = &rgb_layer_base[index];
+        rgb_matrix_set_base(index, rgb_matrix_blend_channel(pixel->r, red, alpha, blend), rgb_matrix_blend_channel(pixel->g, green, alpha, blend), rgb_matrix_blend_channel(pixel->b, blue, alpha, blend));
+    } else {
+        rgb_matrix_set_overlay(index, red, green, blue, alpha, blend);
+    }
+}
+#endif // RGB_MATRIX_COMPOSITOR
+
+#ifdef RGB_MATRIX_DITHERING
+// Sends the integer part of each channel plus the fraction carried over from
+// previous frames, and carries the new fraction forward, so that over a few
+// frames the average output matches the 8.8 value
+static void rgb_matrix_dither(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint16_t *pixel = &rgb_dither_frame[i * 3];
+        uint8_t  *error = &rgb_dither_error[i * 3];
+        uint8_t   out[3];
+        for (uint8_t c = 0; c < 3; c++) {
+            uint16_t sum = pixel[c] + error[c];
+            out[c]       = sum >> 8;
+            error[c]     = sum & 0xFF;
+        }
+        rgb_matrix_output_color(i, out[0], out[1], out[2]);
+    }
+}
+#endif // RGB_MATRIX_DITHERING
+
+// Sends what is held back from the driver until the flush
+static void rgb_matrix_output_frame(void) {
+#ifdef RGB_MATRIX_COMPOSITOR
+    rgb_matrix_compose();
+#endif // RGB_MATRIX_COMPOSITOR
+#ifdef RGB_MATRIX_DITHERING
+    rgb_matrix_dither();
+#endif // RGB_MATRIX_DITHERING
+}
+
+static void rgb_matrix_flush(void) {
+#ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+    rgb_flushed_hash = rgb_frame_hash;
+    rgb_frame_hash   = RGB_MATRIX_FRAME_HASH_INIT;
+#endif // RGB_MATRIX_STATIC_FRAME_SKIP
+    rgb_matrix_output.flush();
+}
+
 void rgb_matrix_update_pwm_buffers(void) {
-    rgb_matrix_driver.flush();
+    // Colours set outside of the effect (eg. by keyboard code followed by a direct call to this) must reach the driver too
+    rgb_matrix_output_frame();
+    rgb_matrix_flush();
+}
+
+void rgb_matrix_set_color16(int index, uint16_t red, uint16_t green, uint16_t blue) {
+#ifdef RGB_MATRIX_DITHERING
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) return;
+#    ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+    rgb_matrix_overlay_written(index, red >> 8, green >> 8, blue >> 8);
+#    endif // RGB_MATRIX_STATIC_FRAME_SKIP
+    // Anything above full brightness would overflow once the carried fraction is added
+    uint16_t *pixel = &rgb_dither_frame[index * 3];
+    pixel[0]        = red < RGB_MATRIX_DITHER_MAX ? red : RGB_MATRIX_DITHER_MAX;
+    pixel[1]        = green < RGB_MATRIX_DITHER_MAX ? green : RGB_MATRIX_DITHER_MAX;
+    pixel[2]        = blue < RGB_MATRIX_DITHER_MAX ? blue : RGB_MATRIX_DITHER_MAX;
+#else
+    rgb_matrix_set_color(index, red >> 8, green >> 8, blue >> 8);
+#endif // RGB_MATRIX_DITHERING
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
-    rgb_matrix_driver.set_color(index, red, green, blue);
+#ifdef RGB_MATRIX_COMPOSITOR
+    // Effects draw the base layer, anything else (eg. indicators) draws over it
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) return;
+    if (rgb_effect_drawing) {
+        rgb_matrix_set_base(index, red, green, blue);
+    } else {
+        rgb_matrix_set_overlay(index, red, green, blue, 255, RGB_MATRIX_BLEND_NORMAL);
+    }
+#elif defined(RGB_MATRIX_DITHERING)
+    rgb_matrix_set_color16(index, red << 8, green << 8, blue << 8);
+#else
+#    ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+    rgb_matrix_overlay_written(index, red, green, blue);
+#    endif // RGB_MATRIX_STATIC_FRAME_SKIP
+    rgb_matrix_output_color(index, red, green, blue);
+#endif // RGB_MATRIX_COMPOSITOR
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#if defined(RGB_MATRIX_COMPOSITOR) || defined(RGB_MATRIX_DITHERING) || (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT))
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
-    rgb_matrix_driver.set_color_all(red, green, blue);
+#    ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+    rgb_matrix_driver_written(-1, red, green, blue);
+#    endif // RGB_MATRIX_STATIC_FRAME_SKIP
+    rgb_matrix_output.set_color_all(red, green, blue);
 #endif
 }
 
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+// Forgets the oldest hits
+static void last_hit_drop(uint8_t count) {
+    uint8_t keep = last_hit_buffer.count - count;
+    memmove(&last_hit_buffer.x[0], &last_hit_buffer.x[count], keep);
+    memmove(&last_hit_buffer.y[0], &last_hit_buffer.y[count], keep);
+    memmove(&last_hit_buffer.tick[0], &last_hit_buffer.tick[count], keep * sizeof(last_hit_buffer.tick[0]));
+    memmove(&last_hit_buffer.index[0], &last_hit_buffer.index[count], keep);
+#    ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+    memmove(&last_hit_time[0], &last_hit_time[count], keep * sizeof(last_hit_time[0]));
+#    endif
+    last_hit_buffer.count = keep;
+}
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+#ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+static uint16_t rgb_random_seed = 0;
+
+uint16_t rgb_matrix_get_random_seed(void) {
+    return rgb_random_seed;
+}
+
+// Both halves restart the effect from the same random state, once for each config change
+void rgb_matrix_set_random_seed(uint16_t seed) {
+    if (seed == rgb_random_seed) return;
+    rgb_random_seed = seed;
+    random16_set_seed(seed);
+    rgb_last_effect = UINT8_MAX;
+}
+
+void rgb_matrix_reseed_random(void) {
+    random16_add_entropy(sync_timer_read());
+    uint16_t seed = random16();
+    rgb_matrix_set_random_seed(seed != rgb_random_seed ? seed : seed + 1);
+}
+
+void rgb_matrix_get_hit_log(rgb_matrix_hit_log_t *hit_log) {
+    memset(hit_log, 0, sizeof(rgb_matrix_hit_log_t));
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    hit_log->count = last_hit_buffer.count;
+    for (uint8_t i = 0; i < last_hit_buffer.count; i++) {
+        hit_log->index[i] = last_hit_buffer.index[i];
+        hit_log->time[i]  = last_hit_time[i];
+    }
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+}
+
+void rgb_matrix_set_hit_log(const rgb_matrix_hit_log_t *hit_log) {
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    // Hits older than 16 bits of timer are dropped anyway, so the full time follows from the current one
+    uint32_t now   = sync_timer_read32();
+    uint8_t  count = 0;
+    for (uint8_t i = 0; i < hit_log->count && i < LED_HITS_TO_REMEMBER; i++) {
+        uint8_t led = hit_log->index[i];
+        if (led >= RGB_MATRIX_LED_COUNT) continue;
+        last_hit_buffer.x[count]     = g_led_config.point[led].x;
+        last_hit_buffer.y[count]     = g_led_config.point[led].y;
+        last_hit_buffer.index[count] = led;
+        last_hit_buffer.tick[count]  = (uint16_t)now - hit_log->time[i];
+        last_hit_time[count]         = now - last_hit_buffer.tick[count];
+        count++;
+    }
+    last_hit_buffer.count = count;
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+}
+#endif // SPLIT_RGB_MATRIX_HITS_ENABLE
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -166,6 +513,9 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #if RGB_MATRIX_TIMEOUT > 0
     rgb_anykey_timer = 0;
 #endif // RGB_MATRIX_TIMEOUT > 0
+#ifdef RGB_MATRIX_ADAPTIVE_BUDGET
+    rgb_key_timer = sync_timer_read32();
+#endif // RGB_MATRIX_ADAPTIVE_BUDGET
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     uint8_t led[LED_HITS_TO_REMEMBER];
@@ -179,13 +529,13 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
     {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
+#    ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+    // The master sees the keys of both halves, and sends its hits over
+    if (!is_keyboard_master()) led_count = 0;
+#    endif
 
     if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
+        last_hit_drop(last_hit_buffer.count + led_count - LED_HITS_TO_REMEMBER);
     }
 
     for (uint8_t i = 0; i < led_count; i++) {
@@ -194,6 +544,9 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
         last_hit_buffer.index[index] = led[i];
         last_hit_buffer.tick[index]  = 0;
+#    ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+        last_hit_time[index] = sync_timer_read32();
+#    endif
         last_hit_buffer.count++;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -246,9 +599,9 @@ static bool rgb_matrix_none(effect_params_t *params) {
 }
 
 static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#if (defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && !defined(SPLIT_RGB_MATRIX_HITS_ENABLE)) || RGB_MATRIX_TIMEOUT > 0
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#endif // (defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && !defined(SPLIT_RGB_MATRIX_HITS_ENABLE)) || RGB_MATRIX_TIMEOUT > 0
     rgb_timer_buffer = sync_timer_read32();
 
     // Update double buffer timers
@@ -259,7 +612,18 @@ static void rgb_task_timers(void) {
 #endif // RGB_MATRIX_TIMEOUT > 0
 
     // Update double buffer last hit timers
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+    // Ticks follow from the synced timer rather than adding up, so both halves agree on them
+    uint32_t now     = sync_timer_read32();
+    uint8_t  expired = 0;
+    while (expired < last_hit_buffer.count && now - last_hit_time[expired] > UINT16_MAX) {
+        expired++;
+    }
+    if (expired) last_hit_drop(expired);
+    for (uint8_t i = 0; i < last_hit_buffer.count; ++i) {
+        last_hit_buffer.tick[i] = now - last_hit_time[i];
+    }
+#elif defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
     uint8_t count = last_hit_buffer.count;
     for (uint8_t i = 0; i < count; ++i) {
         if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
@@ -274,31 +638,163 @@ static void rgb_task_timers(void) {
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
     // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_FLUSH_INTERVAL) rgb_task_state = STARTING;
 }
 
+#ifdef RGB_MATRIX_ADAPTIVE_BUDGET
+static void rgb_budget_measure(rgb_task_states state, uint32_t elapsed) {
+    if (state == RENDERING) {
+        rgb_render_ms += elapsed;
+        if (rgb_render_steps < UINT8_MAX) rgb_render_steps++;
+    } else if (state == FLUSHING) {
+        rgb_flush_ms += elapsed;
+    }
+}
+
+// Moves an estimate a quarter of the way towards the latest measurement
+static uint16_t rgb_budget_average(uint16_t estimate, uint32_t measured) {
+    if (measured > UINT16_MAX) measured = UINT16_MAX;
+    return (int32_t)estimate + ((int32_t)measured - estimate) / 4;
+}
+
+// The timer only counts whole milliseconds, but a step lasting a fraction of a
+// millisecond crosses a tick in that fraction of frames, so the averages still
+// converge on the real time
+static void rgb_budget_update(void) {
+    if (rgb_render_steps == 0) return;
+
+    rgb_step_time  = rgb_budget_average(rgb_step_time, rgb_render_ms * 1000UL / rgb_render_steps);
+    rgb_frame_time = rgb_budget_average(rgb_frame_time, (rgb_render_ms + rgb_flush_ms) * 1000UL);
+    rgb_render_ms = rgb_flush_ms = rgb_render_steps = 0;
+
+    // Fewer LEDs per step once steps take too long, more again while there is headroom
+    if (rgb_step_time > RGB_MATRIX_ADAPTIVE_STEP_LIMIT) {
+        uint8_t limit     = (uint32_t)rgb_process_limit * RGB_MATRIX_ADAPTIVE_STEP_LIMIT / rgb_step_time;
+        rgb_process_limit = limit > 0 ? limit : 1;
+    } else if (rgb_step_time < RGB_MATRIX_ADAPTIVE_STEP_LIMIT / 2 && rgb_process_limit < RGB_MATRIX_LED_COUNT) {
+        uint16_t limit    = rgb_process_limit + rgb_process_limit / 4 + 1;
+        rgb_process_limit = limit < RGB_MATRIX_LED_COUNT ? limit : RGB_MATRIX_LED_COUNT;
+    }
+
+    // Slow down as soon as typing starts, then speed back up gradually once idle
+    if (sync_timer_elapsed32(rgb_key_timer) < RGB_MATRIX_ADAPTIVE_IDLE_TIME) {
+        rgb_flush_limit = RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MAX;
+    } else if (rgb_flush_limit > RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MIN) {
+        rgb_flush_limit--;
+    }
+
+    // Leave at least half of the time between frames to the rest of the keyboard
+    uint16_t busy = (rgb_frame_time * 2 + 999) / 1000;
+    if (rgb_flush_limit < busy) rgb_flush_limit = busy;
+}
+#endif // RGB_MATRIX_ADAPTIVE_BUDGET
+
 static void rgb_task_start(void) {
+#ifdef RGB_MATRIX_ADAPTIVE_BUDGET
+    // only between frames, as the LED ranges of each step must not shift mid-frame
+    rgb_budget_update();
+#endif // RGB_MATRIX_ADAPTIVE_BUDGET
+
     // reset iter
     rgb_effect_params.iter = 0;
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
+#ifdef RGB_MATRIX_COMPOSITOR
+    rgb_matrix_overlay_start();
+#endif // RGB_MATRIX_COMPOSITOR
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    // Only the LEDs referenced by the outgoing or incoming hits need touching
+    for (uint8_t i = 0; i < g_last_hit_tracker.count; ++i) {
+        g_last_hit_led[g_last_hit_tracker.index[i]] = LED_HIT_NONE;
+    }
     g_last_hit_tracker = last_hit_buffer;
+    for (uint8_t i = 0; i < g_last_hit_tracker.count; ++i) {
+        g_last_hit_led[g_last_hit_tracker.index[i]] = i;
+    }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
     rgb_task_state = RENDERING;
 }
 
+#ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+__attribute__((weak)) bool rgb_matrix_effect_is_static_kb(uint8_t mode) {
+    return rgb_matrix_effect_is_static_user(mode);
+}
+
+__attribute__((weak)) bool rgb_matrix_effect_is_static_user(uint8_t mode) {
+    return false;
+}
+
+// Whether the effect draws the same frame for as long as the config stays the same
+static bool rgb_matrix_effect_is_static(uint8_t effect) {
+    switch (effect) {
+        case RGB_MATRIX_SOLID_COLOR:
+#    ifdef ENABLE_RGB_MATRIX_ALPHAS_MODS
+        case RGB_MATRIX_ALPHAS_MODS:
+#    endif
+#    ifdef ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
+        case RGB_MATRIX_GRADIENT_UP_DOWN:
+#    endif
+#    ifdef ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
+        case RGB_MATRIX_GRADIENT_LEFT_RIGHT:
+#    endif
+            return true;
+        default:
+            return rgb_matrix_effect_is_static_kb(effect);
+    }
+}
+
+#endif // RGB_MATRIX_STATIC_FRAME_SKIP
+
+#if defined(RGB_MATRIX_STATIC_FRAME_SKIP) || defined(RGB_MATRIX_COMPOSITOR)
+// The previous frame can be kept if it was drawn by a static effect from the
+// same config and what was drawn over it hasn't changed since, or if the
+// compositor is holding the base effect back until its next redraw
+static bool rgb_task_keep_frame(uint8_t effect) {
+    bool keep = false;
+#    ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+    keep            = !rgb_frame_overlaid && rgb_matrix_effect_is_static(effect) && rgb_last_config.raw == rgb_matrix_config.raw;
+    rgb_last_config = rgb_matrix_config;
+#    endif // RGB_MATRIX_STATIC_FRAME_SKIP
+#    if defined(RGB_MATRIX_COMPOSITOR) && RGB_MATRIX_COMPOSITOR_BASE_INTERVAL > 0
+    if (!keep && !rgb_effect_params.init && sync_timer_elapsed32(rgb_base_timer) < RGB_MATRIX_COMPOSITOR_BASE_INTERVAL) {
+        keep = true;
+    }
+    if (!keep || rgb_effect_params.init) {
+        rgb_base_timer = sync_timer_read32();
+    }
+#    endif
+    return keep && !rgb_effect_params.init;
+}
+#endif
+
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
+    rgb_effect_drawing     = true;
     if (rgb_effect_params.flags != rgb_matrix_config.flags) {
         rgb_effect_params.flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+#if defined(RGB_MATRIX_STATIC_FRAME_SKIP) || defined(RGB_MATRIX_COMPOSITOR)
+    if (rgb_effect_params.iter == 0) {
+        rgb_frame_kept = effect != RGB_MATRIX_NONE && rgb_task_keep_frame(effect);
+    }
+    if (rgb_frame_kept && effect == rgb_last_effect) {
+        // Step through the LED ranges without drawing, so advanced indicators still see each of them
+        RGB_MATRIX_USE_LIMITS_ITER(led_min, led_max, rgb_effect_params.iter);
+        rgb_effect_drawing = false;
+        rgb_effect_params.iter++;
+        if (!rgb_matrix_check_finished_leds(led_max)) {
+            rgb_task_state = FLUSHING;
+        }
+        return;
+    }
+#endif
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -334,10 +830,12 @@ static void rgb_task_render(uint8_t effect) {
         // Factory default magic value
         case UINT8_MAX: {
             rgb_matrix_test();
-            rgb_task_state = FLUSHING;
+            rgb_effect_drawing = false;
+            rgb_task_state     = FLUSHING;
         }
             return;
     }
+    rgb_effect_drawing = false;
 
     rgb_effect_params.iter++;
 
@@ -356,8 +854,29 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
+#ifdef RGB_MATRIX_COMPOSITOR
+    // nothing draws overlays while the matrix is off
+    if (effect == RGB_MATRIX_NONE) {
+        memset(rgb_overlay_drawn, 0, RGB_MATRIX_LED_BITMAP_SIZE);
+    }
+#endif // RGB_MATRIX_COMPOSITOR
+
+#ifdef RGB_MATRIX_STATIC_FRAME_SKIP
+    // Writing the same as before the last flush leaves the driver with what the LEDs already show
+    rgb_matrix_output_frame();
+    if (rgb_frame_hash != rgb_flushed_hash) {
+        rgb_matrix_flush();
+    } else {
+        rgb_frame_hash = RGB_MATRIX_FRAME_HASH_INIT;
+    }
+
+    rgb_frame_overlaid    = rgb_overlay_hash != rgb_last_overlay_hash;
+    rgb_last_overlay_hash = rgb_overlay_hash;
+    rgb_overlay_hash      = RGB_MATRIX_FRAME_HASH_INIT;
+#else
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
+#endif
 
     // next task
     rgb_task_state = SYNCING;
@@ -376,6 +895,11 @@ void rgb_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
+#ifdef RGB_MATRIX_ADAPTIVE_BUDGET
+    rgb_task_states state = rgb_task_state;
+    uint32_t        start = timer_read32();
+#endif // RGB_MATRIX_ADAPTIVE_BUDGET
+
     switch (rgb_task_state) {
         case STARTING:
             rgb_task_start();
@@ -396,6 +920,10 @@ void rgb_matrix_task(void) {
             rgb_task_sync();
             break;
     }
+
+#ifdef RGB_MATRIX_ADAPTIVE_BUDGET
+    rgb_budget_measure(state, timer_elapsed32(start));
+#endif // RGB_MATRIX_ADAPTIVE_BUDGET
 }
 
 void rgb_matrix_indicators(void) {
@@ -410,19 +938,25 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
     return true;
 }
 
+#ifdef RGB_MATRIX_ADAPTIVE_BUDGET
+#    define RGB_MATRIX_PROCESS_LIMIT rgb_process_limit
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#    define RGB_MATRIX_PROCESS_LIMIT RGB_MATRIX_LED_PROCESS_LIMIT
+#endif
+
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_PROCESS_LIMIT)
 #    if defined(RGB_MATRIX_SPLIT)
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_PROCESS_LIMIT * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_PROCESS_LIMIT;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
     uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
     if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
     if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
 #    else
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_PROCESS_LIMIT * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_PROCESS_LIMIT;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
 #    endif
 #else
@@ -458,14 +992,27 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+void rgb_matrix_update_led_geometry(void) {
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx           = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy           = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_led_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_polar[i].angle = atan2_8(dy, dx);
+    }
+#endif
+}
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+    rgb_matrix_update_led_geometry();
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
         g_last_hit_tracker.tick[i] = UINT16_MAX;
     }
+    memset(g_last_hit_led, LED_HIT_NONE, sizeof(g_last_hit_led));
 
     last_hit_buffer.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
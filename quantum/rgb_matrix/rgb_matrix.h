@@ -107,6 +107,50 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+// How many LEDs the effect runners convert from HSV to RGB at once
+#ifndef RGB_MATRIX_HSV_QUEUE_SIZE
+#    define RGB_MATRIX_HSV_QUEUE_SIZE 8
+#endif
+
+// Per-LED distance and angle from the center are computed once at init, rather than every frame -- costs 2 bytes of RAM per LED
+#if !defined(RGB_MATRIX_LED_GEOMETRY_CACHE) && !defined(RGB_MATRIX_NO_LED_GEOMETRY_CACHE) && !defined(__AVR__)
+#    define RGB_MATRIX_LED_GEOMETRY_CACHE
+#endif
+
+#ifdef RGB_MATRIX_COMPOSITOR
+// Minimum time in milliseconds between redraws of the base effect, indicators still update every frame
+#    ifndef RGB_MATRIX_COMPOSITOR_BASE_INTERVAL
+#        define RGB_MATRIX_COMPOSITOR_BASE_INTERVAL 0
+#    endif
+#endif
+
+#if defined(SPLIT_RGB_MATRIX_HITS_ENABLE) && !defined(RGB_MATRIX_SPLIT)
+#    error "SPLIT_RGB_MATRIX_HITS_ENABLE requires RGB_MATRIX_SPLIT"
+#endif
+
+#ifdef RGB_MATRIX_ADAPTIVE_BUDGET
+// Longest a single render step may keep the matrix scan waiting, in microseconds
+#    ifndef RGB_MATRIX_ADAPTIVE_STEP_LIMIT
+#        define RGB_MATRIX_ADAPTIVE_STEP_LIMIT 500
+#    endif
+// Time between frames in milliseconds while idle, and while typing
+#    ifndef RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MIN
+#        define RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MIN (RGB_MATRIX_LED_FLUSH_LIMIT / 2)
+#    endif
+#    ifndef RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MAX
+#        define RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MAX (RGB_MATRIX_LED_FLUSH_LIMIT * 2)
+#    endif
+// Time in milliseconds since the last key event after which the keyboard is idle
+#    ifndef RGB_MATRIX_ADAPTIVE_IDLE_TIME
+#        define RGB_MATRIX_ADAPTIVE_IDLE_TIME 1000
+#    endif
+#endif
+
+// Dithering blends the 8.8 frame into the 8-bit driver output over time, which the compositor's 8-bit layers cannot feed
+#if defined(RGB_MATRIX_DITHERING) && defined(RGB_MATRIX_COMPOSITOR)
+#    error "RGB_MATRIX_DITHERING cannot be used together with RGB_MATRIX_COMPOSITOR"
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -164,6 +208,26 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+// Sends the colours set so far to the LEDs, without waiting for the next frame
+void rgb_matrix_update_pwm_buffers(void);
+void rgb_matrix_set_color16(int index, uint16_t red, uint16_t green, uint16_t blue);
+
+RGB  rgb_matrix_hsv_to_rgb(HSV hsv);
+void rgb_matrix_hsv_to_rgb_buffer(const HSV *hsv, RGB *rgb, uint8_t count);
+// Sets the colour of an LED once a few have been queued, so they are converted together
+void rgb_matrix_queue_hsv(uint8_t index, HSV hsv);
+void rgb_matrix_send_queued_hsv(void);
+
+#ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+uint16_t rgb_matrix_get_random_seed(void);
+void     rgb_matrix_set_random_seed(uint16_t seed);
+void     rgb_matrix_reseed_random(void);
+void     rgb_matrix_get_hit_log(rgb_matrix_hit_log_t *hit_log);
+void     rgb_matrix_set_hit_log(const rgb_matrix_hit_log_t *hit_log);
+#endif
+#ifdef RGB_MATRIX_COMPOSITOR
+void rgb_matrix_set_color_blend(int index, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha, rgb_matrix_blend_t blend);
+#endif
 
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
@@ -172,6 +236,11 @@ void rgb_matrix_task(void);
 // This runs after another backlight effect and replaces
 // colors already set
 void rgb_matrix_indicators(void);
+bool rgb_matrix_effect_is_static_kb(uint8_t mode);
+bool rgb_matrix_effect_is_static_user(uint8_t mode);
+// Notes a write made straight to rgb_matrix_driver, see rgb_matrix_drivers.c
+void rgb_matrix_driver_written(int index, uint8_t red, uint8_t green, uint8_t blue);
+
 bool rgb_matrix_indicators_kb(void);
 bool rgb_matrix_indicators_user(void);
 
@@ -180,6 +249,7 @@ bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
+void rgb_matrix_update_led_geometry(void);
 
 void rgb_matrix_reload_from_eeprom(void);
 
@@ -296,13 +366,22 @@ static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
 }
 
 extern const rgb_matrix_driver_t rgb_matrix_driver;
+#if defined(RGB_MATRIX_STATIC_FRAME_SKIP) && !defined(RGB_MATRIX_CUSTOM)
+// The selected driver, which rgb_matrix_driver wraps
+extern const rgb_matrix_driver_t rgb_matrix_untracked_driver;
+#endif
 
 extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+extern led_polar_t g_led_polar[RGB_MATRIX_LED_COUNT];
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
+// Index into g_last_hit_tracker of each LED's most recent hit, or LED_HIT_NONE
+extern uint8_t g_last_hit_led[RGB_MATRIX_LED_COUNT];
 #endif
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
@@ -24,8 +24,15 @@
  * be here if shared between boards.
  */
 
+#if defined(RGB_MATRIX_STATIC_FRAME_SKIP) && !defined(RGB_MATRIX_CUSTOM)
+// The selected driver is wrapped at the end of this file, so that writes which bypass rgb_matrix_set_color() are noticed
+#    define RGB_MATRIX_SELECTED_DRIVER rgb_matrix_untracked_driver
+#else
+#    define RGB_MATRIX_SELECTED_DRIVER rgb_matrix_driver
+#endif
+
 #if defined(RGB_MATRIX_IS31FL3218)
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = is31fl3218_init,
     .flush         = is31fl3218_update_pwm_buffers,
     .set_color     = is31fl3218_set_color,
@@ -33,7 +40,7 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(RGB_MATRIX_IS31FL3731)
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = is31fl3731_init_drivers,
     .flush         = is31fl3731_flush,
     .set_color     = is31fl3731_set_color,
@@ -41,7 +48,7 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(RGB_MATRIX_IS31FL3733)
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = is31fl3733_init_drivers,
     .flush         = is31fl3733_flush,
     .set_color     = is31fl3733_set_color,
@@ -49,7 +56,7 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(RGB_MATRIX_IS31FL3736)
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = is31fl3736_init_drivers,
     .flush         = is31fl3736_flush,
     .set_color     = is31fl3736_set_color,
@@ -57,7 +64,7 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(RGB_MATRIX_IS31FL3737)
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = is31fl3737_init_drivers,
     .flush         = is31fl3737_flush,
     .set_color     = is31fl3737_set_color,
@@ -65,7 +72,7 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(RGB_MATRIX_IS31FL3741)
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = is31fl3741_init_drivers,
     .flush         = is31fl3741_flush,
     .set_color     = is31fl3741_set_color,
@@ -73,7 +80,7 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(IS31FLCOMMON)
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = IS31FL_RGB_init_drivers,
     .flush         = IS31FL_common_flush,
     .set_color     = IS31FL_RGB_set_color,
@@ -81,7 +88,7 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(RGB_MATRIX_SNLED27351)
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = snled27351_init_drivers,
     .flush         = snled27351_flush,
     .set_color     = snled27351_set_color,
@@ -89,7 +96,7 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(RGB_MATRIX_AW20216S)
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = aw20216s_init_drivers,
     .flush         = aw20216s_flush,
     .set_color     = aw20216s_set_color,
@@ -97,11 +104,19 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(RGB_MATRIX_WS2812)
-#    if defined(RGBLIGHT_WS2812)
-#        pragma message "Cannot use RGBLIGHT and RGB Matrix using WS2812 at the same time."
-#        pragma message "You need to use a custom driver, or re-implement the WS2812 driver to use a different configuration."
-#    endif
+#    if defined(WS2812_SHARED_FRAMEBUFFER)
+// The chain is shared with rgblight, the LEDs are rendered into its region of the shared frame buffer
+#        include "ws2812_framebuffer.h"
 
+static rgb_led_t *const rgb_matrix_ws2812_array = ws2812_framebuffer + WS2812_RGB_MATRIX_OFFSET;
+#        define ws2812_dirty ws2812_framebuffer_dirty
+
+static void init(void) {}
+
+static void flush(void) {
+    ws2812_framebuffer_flush();
+}
+#    else
 // LED color buffer
 rgb_led_t rgb_matrix_ws2812_array[RGB_MATRIX_LED_COUNT];
 bool      ws2812_dirty = false;
@@ -116,6 +131,7 @@ static void flush(void) {
         ws2812_dirty = false;
     }
 }
+#    endif
 
 // Set an led in the buffer to a color
 static inline void setled(int i, uint8_t r, uint8_t g, uint8_t b) {
@@ -146,12 +162,12 @@ static inline void setled(int i, uint8_t r, uint8_t g, uint8_t b) {
 }
 
 static void setled_all(uint8_t r, uint8_t g, uint8_t b) {
-    for (int i = 0; i < ARRAY_SIZE(rgb_matrix_ws2812_array); i++) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
         setled(i, r, g, b);
     }
 }
 
-const rgb_matrix_driver_t rgb_matrix_driver = {
+const rgb_matrix_driver_t RGB_MATRIX_SELECTED_DRIVER = {
     .init          = init,
     .flush         = flush,
     .set_color     = setled,
@@ -159,3 +175,30 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #endif
+
+#if defined(RGB_MATRIX_STATIC_FRAME_SKIP) && !defined(RGB_MATRIX_CUSTOM)
+static void tracked_init(void) {
+    rgb_matrix_untracked_driver.init();
+}
+
+static void tracked_flush(void) {
+    rgb_matrix_untracked_driver.flush();
+}
+
+static void tracked_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_matrix_driver_written(index, red, green, blue);
+    rgb_matrix_untracked_driver.set_color(index, red, green, blue);
+}
+
+static void tracked_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_matrix_driver_written(-1, red, green, blue);
+    rgb_matrix_untracked_driver.set_color_all(red, green, blue);
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = tracked_init,
+    .flush         = tracked_flush,
+    .set_color     = tracked_set_color,
+    .set_color_all = tracked_set_color_all,
+};
+#endif
@@ -21,6 +21,10 @@
 #include "color.h"
 #include "util.h"
 
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
 #if defined(RGB_MATRIX_KEYPRESSES) || defined(RGB_MATRIX_KEYRELEASES)
 #    define RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif
@@ -31,6 +35,8 @@
 #endif // LED_HITS_TO_REMEMBER
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#    define LED_HIT_NONE UINT8_MAX
+
 typedef struct PACKED {
     uint8_t  count;
     uint8_t  x[LED_HITS_TO_REMEMBER];
@@ -40,6 +46,15 @@ typedef struct PACKED {
 } last_hit_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+// Hits as sent to the other half, by LED and the low 16 bits of the synced timer when they happened
+typedef struct PACKED {
+    uint8_t  count;
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint16_t time[LED_HITS_TO_REMEMBER];
+} rgb_matrix_hit_log_t;
+#endif // SPLIT_RGB_MATRIX_HITS_ENABLE
+
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
 typedef uint8_t led_flags_t;
@@ -55,6 +70,27 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+typedef struct PACKED {
+    uint8_t dist;  // distance from k_rgb_matrix_center
+    uint8_t angle; // atan2_8() of the offset from k_rgb_matrix_center
+} led_polar_t;
+
+#ifdef RGB_MATRIX_COMPOSITOR
+typedef enum rgb_matrix_blend_t {
+    RGB_MATRIX_BLEND_NORMAL,   // mixes towards the color by alpha
+    RGB_MATRIX_BLEND_ADD,      // adds the color scaled by alpha
+    RGB_MATRIX_BLEND_MULTIPLY, // mixes towards the product of both colors by alpha
+} rgb_matrix_blend_t;
+
+typedef struct PACKED {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t alpha;
+    uint8_t blend;
+} rgb_matrix_overlay_t;
+#endif // RGB_MATRIX_COMPOSITOR
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
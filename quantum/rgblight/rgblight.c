@@ -24,6 +24,9 @@
 #include "util.h"
 #include "led_tables.h"
 #include <lib/lib8tion/lib8tion.h>
+#ifdef WS2812_SHARED_FRAMEBUFFER
+#    include "ws2812_framebuffer.h"
+#endif
 #ifdef EEPROM_ENABLE
 #    include "eeprom.h"
 #endif
@@ -884,6 +887,10 @@ void rgblight_suspend(void) {
 
 void rgblight_wakeup(void) {
     is_suspended = false;
+#    ifdef RGBLIGHT_SKIP_UNCHANGED
+    // the LEDs may have been powered off while suspended
+    rgblight_refresh();
+#    endif
 
     if (pre_suspend_enabled) {
         rgblight_enable_noeeprom();
@@ -900,8 +907,24 @@ void rgblight_wakeup(void) {
 
 #endif
 
+#ifdef RGBLIGHT_SKIP_UNCHANGED
+static rgb_led_t last_sent[RGBLED_NUM];
+static uint8_t   last_sent_start;
+static uint8_t   last_sent_num;
+static bool      last_sent_valid = false;
+
+void rgblight_refresh(void) {
+    last_sent_valid = false;
+}
+#endif
+
 __attribute__((weak)) void rgblight_call_driver(rgb_led_t *start_led, uint8_t num_leds) {
+#ifdef WS2812_SHARED_FRAMEBUFFER
+    // the chain is shared with RGB Matrix, this is sent with the next flush of the frame buffer
+    ws2812_framebuffer_write(WS2812_RGBLIGHT_OFFSET + rgblight_ranges.clipping_start_pos, start_led, num_leds);
+#else
     ws2812_setleds(start_led, num_leds);
+#endif
 }
 
 #ifndef RGBLIGHT_CUSTOM
@@ -947,6 +970,16 @@ void rgblight_set(void) {
     for (uint8_t i = 0; i < num_leds; i++) {
         convert_rgb_to_rgbw(&start_led[i]);
     }
+#    endif
+#    ifdef RGBLIGHT_SKIP_UNCHANGED
+    // a strip can't be updated partially, but a frame identical to the last one doesn't need sending at all
+    if (last_sent_valid && last_sent_start == rgblight_ranges.clipping_start_pos && last_sent_num == num_leds && memcmp(last_sent, start_led, num_leds * sizeof(rgb_led_t)) == 0) {
+        return;
+    }
+    memcpy(last_sent, start_led, num_leds * sizeof(rgb_led_t));
+    last_sent_start = rgblight_ranges.clipping_start_pos;
+    last_sent_num   = num_leds;
+    last_sent_valid = true;
 #    endif
     rgblight_call_driver(start_led, num_leds);
 }
@@ -1052,77 +1085,122 @@ static void rgblight_effect_dummy(animation_status_t *anim) {
     **/
 }
 
-void rgblight_timer_task(void) {
-    if (rgblight_status.timer_enabled) {
-        effect_func_t effect_func   = rgblight_effect_dummy;
-        uint16_t      interval_time = 2000; // dummy interval
-        uint8_t       delta         = rgblight_config.mode - rgblight_status.base_mode;
-        animation_status.delta      = delta;
+// Interval of each tick of an animated effect, from its speed `delta`
+typedef uint16_t (*effect_interval_func_t)(uint8_t delta);
+
+typedef struct {
+    uint8_t                base_mode;
+    effect_func_t          func;
+    effect_interval_func_t interval;
+} rgblight_effect_t;
 
-        // static light mode, do nothing here
-        if (1 == 0) { // dummy
-        }
 #    ifdef RGBLIGHT_EFFECT_BREATHING
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_BREATHING) {
-            // breathing mode
-            interval_time = get_interval_time(&RGBLED_BREATHING_INTERVALS[delta], 1, 100);
-            effect_func   = rgblight_effect_breathing;
-        }
+static uint16_t breathing_interval(uint8_t delta) {
+    return get_interval_time(&RGBLED_BREATHING_INTERVALS[delta], 1, 100);
+}
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RAINBOW_MOOD
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_RAINBOW_MOOD) {
-            // rainbow mood mode
-            interval_time = get_interval_time(&RGBLED_RAINBOW_MOOD_INTERVALS[delta], 5, 100);
-            effect_func   = rgblight_effect_rainbow_mood;
-        }
+static uint16_t rainbow_mood_interval(uint8_t delta) {
+    return get_interval_time(&RGBLED_RAINBOW_MOOD_INTERVALS[delta], 5, 100);
+}
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RAINBOW_SWIRL
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_RAINBOW_SWIRL) {
-            // rainbow swirl mode
-            interval_time = get_interval_time(&RGBLED_RAINBOW_SWIRL_INTERVALS[delta / 2], 1, 100);
-            effect_func   = rgblight_effect_rainbow_swirl;
-        }
+static uint16_t rainbow_swirl_interval(uint8_t delta) {
+    return get_interval_time(&RGBLED_RAINBOW_SWIRL_INTERVALS[delta / 2], 1, 100);
+}
 #    endif
 #    ifdef RGBLIGHT_EFFECT_SNAKE
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_SNAKE) {
-            // snake mode
-            interval_time = get_interval_time(&RGBLED_SNAKE_INTERVALS[delta / 2], 1, 200);
-            effect_func   = rgblight_effect_snake;
-        }
+static uint16_t snake_interval(uint8_t delta) {
+    return get_interval_time(&RGBLED_SNAKE_INTERVALS[delta / 2], 1, 200);
+}
 #    endif
 #    ifdef RGBLIGHT_EFFECT_KNIGHT
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_KNIGHT) {
-            // knight mode
-            interval_time = get_interval_time(&RGBLED_KNIGHT_INTERVALS[delta], 5, 100);
-            effect_func   = rgblight_effect_knight;
-        }
+static uint16_t knight_interval(uint8_t delta) {
+    return get_interval_time(&RGBLED_KNIGHT_INTERVALS[delta], 5, 100);
+}
 #    endif
 #    ifdef RGBLIGHT_EFFECT_CHRISTMAS
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_CHRISTMAS) {
-            // christmas mode
-            interval_time = RGBLIGHT_EFFECT_CHRISTMAS_INTERVAL;
-            effect_func   = (effect_func_t)rgblight_effect_christmas;
-        }
+static uint16_t christmas_interval(uint8_t delta) {
+    return RGBLIGHT_EFFECT_CHRISTMAS_INTERVAL;
+}
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RGB_TEST
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_RGB_TEST) {
-            // RGB test mode
-            interval_time = pgm_read_word(&RGBLED_RGBTEST_INTERVALS[0]);
-            effect_func   = (effect_func_t)rgblight_effect_rgbtest;
-        }
+static uint16_t rgbtest_interval(uint8_t delta) {
+    return pgm_read_word(&RGBLED_RGBTEST_INTERVALS[0]);
+}
 #    endif
 #    ifdef RGBLIGHT_EFFECT_ALTERNATING
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_ALTERNATING) {
-            interval_time = 500;
-            effect_func   = (effect_func_t)rgblight_effect_alternating;
-        }
+static uint16_t alternating_interval(uint8_t delta) {
+    return 500;
+}
 #    endif
 #    ifdef RGBLIGHT_EFFECT_TWINKLE
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_TWINKLE) {
-            interval_time = get_interval_time(&RGBLED_TWINKLE_INTERVALS[delta % 3], 5, 30);
-            effect_func   = (effect_func_t)rgblight_effect_twinkle;
-        }
+static uint16_t twinkle_interval(uint8_t delta) {
+    return get_interval_time(&RGBLED_TWINKLE_INTERVALS[delta % 3], 5, 30);
+}
+#    endif
+
+// The animated effects, looked up by base mode once each time the mode changes
+static const rgblight_effect_t rgblight_effects[] = {
+#    ifdef RGBLIGHT_EFFECT_BREATHING
+    {RGBLIGHT_MODE_BREATHING, rgblight_effect_breathing, breathing_interval},
+#    endif
+#    ifdef RGBLIGHT_EFFECT_RAINBOW_MOOD
+    {RGBLIGHT_MODE_RAINBOW_MOOD, rgblight_effect_rainbow_mood, rainbow_mood_interval},
+#    endif
+#    ifdef RGBLIGHT_EFFECT_RAINBOW_SWIRL
+    {RGBLIGHT_MODE_RAINBOW_SWIRL, rgblight_effect_rainbow_swirl, rainbow_swirl_interval},
+#    endif
+#    ifdef RGBLIGHT_EFFECT_SNAKE
+    {RGBLIGHT_MODE_SNAKE, rgblight_effect_snake, snake_interval},
+#    endif
+#    ifdef RGBLIGHT_EFFECT_KNIGHT
+    {RGBLIGHT_MODE_KNIGHT, rgblight_effect_knight, knight_interval},
+#    endif
+#    ifdef RGBLIGHT_EFFECT_CHRISTMAS
+    {RGBLIGHT_MODE_CHRISTMAS, rgblight_effect_christmas, christmas_interval},
+#    endif
+#    ifdef RGBLIGHT_EFFECT_RGB_TEST
+    {RGBLIGHT_MODE_RGB_TEST, rgblight_effect_rgbtest, rgbtest_interval},
+#    endif
+#    ifdef RGBLIGHT_EFFECT_ALTERNATING
+    {RGBLIGHT_MODE_ALTERNATING, rgblight_effect_alternating, alternating_interval},
+#    endif
+#    ifdef RGBLIGHT_EFFECT_TWINKLE
+    {RGBLIGHT_MODE_TWINKLE, rgblight_effect_twinkle, twinkle_interval},
 #    endif
+};
+
+static uint16_t dummy_interval(uint8_t delta) {
+    return 2000;
+}
+
+static const rgblight_effect_t rgblight_effect_none = {0, rgblight_effect_dummy, dummy_interval};
+
+static const rgblight_effect_t *rgblight_find_effect(uint8_t base_mode) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(rgblight_effects); i++) {
+        if (rgblight_effects[i].base_mode == base_mode) {
+            return &rgblight_effects[i];
+        }
+    }
+    // static light mode, do nothing here
+    return &rgblight_effect_none;
+}
+
+void rgblight_timer_task(void) {
+    if (rgblight_status.timer_enabled) {
+        static const rgblight_effect_t *effect    = &rgblight_effect_none;
+        static uint8_t                  base_mode = 0;
+        if (base_mode != rgblight_status.base_mode) {
+            effect    = rgblight_find_effect(rgblight_status.base_mode);
+            base_mode = rgblight_status.base_mode;
+        }
+
+        effect_func_t effect_func   = effect->func;
+        uint8_t       delta         = rgblight_config.mode - rgblight_status.base_mode;
+        uint16_t      interval_time = effect->interval(delta);
+        animation_status.delta      = delta;
+
         if (animation_status.restart) {
             animation_status.restart    = false;
             animation_status.last_timer = sync_timer_read();
@@ -1228,12 +1306,13 @@ void rgblight_effect_rainbow_mood(animation_status_t *anim) {
 __attribute__((weak)) const uint8_t RGBLED_RAINBOW_SWIRL_INTERVALS[] PROGMEM = {100, 50, 20};
 
 void rgblight_effect_rainbow_swirl(animation_status_t *anim) {
-    uint8_t hue;
-    uint8_t i;
+    // the hue offset between neighbouring LEDs, added up rather than multiplied for each one
+    uint8_t hue_step = RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds;
+    uint8_t hue      = anim->current_hue;
 
-    for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
-        hue = (RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds * i + anim->current_hue);
-        sethsv(hue, rgblight_config.sat, rgblight_config.val, (rgb_led_t *)&led[i + rgblight_ranges.effect_start_pos]);
+    for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
+        sethsv(hue, rgblight_config.sat, rgblight_config.val, (rgb_led_t *)&led[i]);
+        hue += hue_step;
     }
     rgblight_set();
 
@@ -1269,25 +1348,25 @@ void rgblight_effect_snake(animation_status_t *anim) {
     }
 #    endif
 
-    for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
-        rgb_led_t *ledp = led + i + rgblight_ranges.effect_start_pos;
-        ledp->r         = 0;
-        ledp->g         = 0;
-        ledp->b         = 0;
+    for (i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
+        led[i].r = 0;
+        led[i].g = 0;
+        led[i].b = 0;
 #    ifdef RGBW
-        ledp->w = 0;
+        led[i].w = 0;
 #    endif
-        for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
-            k = pos + j * increment;
-            if (k > RGBLED_NUM) {
-                k = k % (RGBLED_NUM);
-            }
-            if (k < 0) {
-                k = k + rgblight_ranges.effect_num_leds;
-            }
-            if (i == k) {
-                sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val * (RGBLIGHT_EFFECT_SNAKE_LENGTH - j) / RGBLIGHT_EFFECT_SNAKE_LENGTH), ledp);
-            }
+    }
+    // only the LEDs of the snake itself are lit, a later segment wins where they overlap
+    for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
+        k = pos + j * increment;
+        if (k > RGBLED_NUM) {
+            k = k % (RGBLED_NUM);
+        }
+        if (k < 0) {
+            k = k + rgblight_ranges.effect_num_leds;
+        }
+        if (k >= 0 && k < rgblight_ranges.effect_num_leds) {
+            sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val * (RGBLIGHT_EFFECT_SNAKE_LENGTH - j) / RGBLIGHT_EFFECT_SNAKE_LENGTH), &led[k + rgblight_ranges.effect_start_pos]);
         }
     }
     rgblight_set();
@@ -1338,9 +1417,13 @@ void rgblight_effect_knight(animation_status_t *anim) {
         led[i].w = 0;
 #    endif
     }
-    // Determine which LEDs should be lit up
-    for (i = 0; i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM; i++) {
-        cur = (i + RGBLIGHT_EFFECT_KNIGHT_OFFSET) % rgblight_ranges.effect_num_leds + rgblight_ranges.effect_start_pos;
+    // Determine which LEDs should be lit up, walking the range from the offset
+    // and wrapping around at its end
+    cur = RGBLIGHT_EFFECT_KNIGHT_OFFSET % rgblight_ranges.effect_num_leds + rgblight_ranges.effect_start_pos;
+    for (i = 0; i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM; i++, cur++) {
+        if (cur == rgblight_ranges.effect_end_pos) {
+            cur = rgblight_ranges.effect_start_pos;
+        }
 
         if (i >= low_bound && i <= high_bound) {
             sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, (rgb_led_t *)&led[cur]);
@@ -290,6 +290,10 @@ void setrgb(uint8_t r, uint8_t g, uint8_t b, rgb_led_t *led1);
 
 /* === Low level Functions === */
 void rgblight_set(void);
+#ifdef RGBLIGHT_SKIP_UNCHANGED
+/* Make the next rgblight_set() send all LEDs, even if they didn't change */
+void rgblight_refresh(void);
+#endif
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds);
 
 /* === Effects and Animations Functions === */
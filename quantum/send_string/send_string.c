@@ -29,7 +29,7 @@
 #    ifndef BELL_SOUND
 #        define BELL_SOUND TERMINAL_SOUND
 #    endif
-float bell_song[][2] = SONG(BELL_SOUND);
+musical_note_t bell_song[] = SONG(BELL_SOUND);
 #endif
 
 // clang-format off
@@ -550,6 +550,15 @@ static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_
     rgb_matrix_sync_t rgb_matrix_sync;
     memcpy(&rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
     rgb_matrix_sync.rgb_suspend_state = rgb_matrix_get_suspend_state();
+#    ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+    // A new seed for each config change, sent along with the config
+    static rgb_config_t last_config = {0};
+    if (memcmp(&last_config, &rgb_matrix_config, sizeof(rgb_config_t)) != 0) {
+        memcpy(&last_config, &rgb_matrix_config, sizeof(rgb_config_t));
+        rgb_matrix_reseed_random();
+    }
+    rgb_matrix_sync.random_seed = rgb_matrix_get_random_seed();
+#    endif // SPLIT_RGB_MATRIX_HITS_ENABLE
     return send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
 }
 
@@ -557,14 +566,64 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     split_shared_memory_lock();
     memcpy(&rgb_matrix_config, &split_shmem->rgb_matrix_sync.rgb_matrix, sizeof(rgb_config_t));
     bool rgb_suspend_state = split_shmem->rgb_matrix_sync.rgb_suspend_state;
+#    ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+    uint16_t random_seed = split_shmem->rgb_matrix_sync.random_seed;
+#    endif // SPLIT_RGB_MATRIX_HITS_ENABLE
     split_shared_memory_unlock();
 
     rgb_matrix_set_suspend_state(rgb_suspend_state);
+#    ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+    rgb_matrix_set_random_seed(random_seed);
+#    endif // SPLIT_RGB_MATRIX_HITS_ENABLE
 }
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+
+// Hits only change on key events, so nothing is sent while the halves render on their own.
+// They fade out within seconds, so unlike the config they aren't resent periodically.
+static bool rgb_matrix_hits_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static rgb_matrix_hit_log_t last_hit_log = {0};
+    rgb_matrix_hit_log_t        hit_log;
+    rgb_matrix_get_hit_log(&hit_log);
+    if (memcmp(&hit_log, &last_hit_log, sizeof(hit_log)) == 0) {
+        return true;
+    }
+
+    bool okay = transport_write(PUT_RGB_MATRIX_HITS, &hit_log, sizeof(hit_log));
+    if (okay) {
+        memcpy(&last_hit_log, &hit_log, sizeof(hit_log));
+    }
+    return okay;
+}
+
+static void rgb_matrix_hits_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static rgb_matrix_hit_log_t last_hit_log = {0};
+    rgb_matrix_hit_log_t        hit_log;
+    split_shared_memory_lock();
+    memcpy(&hit_log, &split_shmem->rgb_matrix_hits, sizeof(hit_log));
+    split_shared_memory_unlock();
+
+    if (memcmp(&hit_log, &last_hit_log, sizeof(hit_log)) != 0) {
+        memcpy(&last_hit_log, &hit_log, sizeof(hit_log));
+        rgb_matrix_set_hit_log(&hit_log);
+    }
+}
+
+// clang-format off
+#        define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix); TRANSACTION_HANDLER_MASTER(rgb_matrix_hits)
+#        define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix); TRANSACTION_HANDLER_SLAVE(rgb_matrix_hits)
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS \
+    [PUT_RGB_MATRIX]      = trans_initiator2target_initializer(rgb_matrix_sync), \
+    [PUT_RGB_MATRIX_HITS] = trans_initiator2target_initializer(rgb_matrix_hits),
+// clang-format on
+
+#    else // SPLIT_RGB_MATRIX_HITS_ENABLE
+
+#        define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
+#        define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+
+#    endif // SPLIT_RGB_MATRIX_HITS_ENABLE
 
 #else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -92,6 +92,9 @@ typedef struct _led_matrix_sync_t {
 typedef struct _rgb_matrix_sync_t {
     rgb_config_t rgb_matrix;
     bool         rgb_suspend_state;
+#    ifdef SPLIT_RGB_MATRIX_HITS_ENABLE
+    uint16_t random_seed;
+#    endif // SPLIT_RGB_MATRIX_HITS_ENABLE
 } rgb_matrix_sync_t;
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -193,6 +196,10 @@ typedef struct _split_shared_memory_t {
     rgb_matrix_sync_t rgb_matrix_sync;
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+    rgb_matrix_hit_log_t rgb_matrix_hits;
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
     uint8_t current_wpm;
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
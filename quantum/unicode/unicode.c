@@ -81,22 +81,22 @@ __attribute__((weak)) void unicode_input_mode_set_kb(uint8_t input_mode) {
 
 #ifdef AUDIO_ENABLE
 #    ifdef UNICODE_SONG_MAC
-static float song_mac[][2] = UNICODE_SONG_MAC;
+static musical_note_t song_mac[] = UNICODE_SONG_MAC;
 #    endif
 #    ifdef UNICODE_SONG_LNX
-static float song_lnx[][2] = UNICODE_SONG_LNX;
+static musical_note_t song_lnx[] = UNICODE_SONG_LNX;
 #    endif
 #    ifdef UNICODE_SONG_WIN
-static float song_win[][2] = UNICODE_SONG_WIN;
+static musical_note_t song_win[] = UNICODE_SONG_WIN;
 #    endif
 #    ifdef UNICODE_SONG_BSD
-static float song_bsd[][2] = UNICODE_SONG_BSD;
+static musical_note_t song_bsd[] = UNICODE_SONG_BSD;
 #    endif
 #    ifdef UNICODE_SONG_WINC
-static float song_winc[][2] = UNICODE_SONG_WINC;
+static musical_note_t song_winc[] = UNICODE_SONG_WINC;
 #    endif
 #    ifdef UNICODE_SONG_EMACS
-static float song_emacs[][2] = UNICODE_SONG_EMACS;
+static musical_note_t song_emacs[] = UNICODE_SONG_EMACS;
 #    endif
 
 static void unicode_play_song(uint8_t mode) {
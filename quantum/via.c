@@ -144,7 +144,7 @@ void via_set_layout_options(uint32_t value) {
 }
 
 #if defined(AUDIO_ENABLE)
-float via_device_indication_song[][2] = SONG(STARTUP_SOUND);
+musical_note_t via_device_indication_song[] = SONG(STARTUP_SOUND);
 #endif // AUDIO_ENABLE
 
 // Used by VIA to tell a device to flash LEDs (or do something else) when that
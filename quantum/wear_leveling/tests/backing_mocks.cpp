@@ -24,6 +24,8 @@ void MockBackingStore::reset_instance() {
     backing_write_invoke_count  = 0;
     backing_lock_invoke_count   = 0;
 
+    backing_erase_block_invoke_count = 0;
+
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
     unlock_success_callback = [](std::uint64_t) { return true; };
@@ -75,6 +77,28 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool MockBackingStore::erase_block(uint32_t address) {
+    ++backing_erase_block_invoke_count;
+
+    EXPECT_TRUE(address % BACKING_STORE_ERASE_SIZE == 0) << "Supplied address was not aligned with the backing store erase size";
+    EXPECT_TRUE(address + BACKING_STORE_ERASE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+
+    // Drop out of erase early with failure if we need to
+    if (erase_success_callback && !erase_success_callback(backing_erase_block_invoke_count)) {
+        return false;
+    }
+
+    // Erase each slot within the block
+    for (std::size_t i = address / BACKING_STORE_WRITE_SIZE; i < (address + BACKING_STORE_ERASE_SIZE) / BACKING_STORE_WRITE_SIZE; ++i) {
+        backing_storage[i].erase();
+    }
+
+    return true;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -152,3 +176,9 @@ extern "C" bool backing_store_lock(void) {
 extern "C" bool backing_store_read(uint32_t address, backing_store_int_t* value) {
     return MockBackingStore::Instance().read(address, *value);
 }
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+extern "C" bool backing_store_erase_block(uint32_t address) {
+    return MockBackingStore::Instance().erase_block(address);
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
@@ -96,6 +96,7 @@ class MockBackingStore {
     std::uint64_t backing_erase_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
+    std::uint64_t backing_erase_block_invoke_count;
 
     // Whether init should succeed
     std::function<bool(std::uint64_t)> init_success_callback;
@@ -147,6 +148,9 @@ class MockBackingStore {
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
+    std::uint64_t erase_block_invoke_count() const {
+        return backing_erase_block_invoke_count;
+    }
 
     // Clear out the internal data for the next run
     void reset_instance();
@@ -162,6 +166,9 @@ class MockBackingStore {
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    bool erase_block(std::uint32_t address);
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
     // Control over when init/writes/erases should succeed
     void set_init_callback(std::function<bool(std::uint64_t)> callback) {
@@ -0,0 +1,186 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingIncremental : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+        write_counter = 0;
+    }
+
+    static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+    static std::uint32_t                                        write_counter;
+
+    static wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+        memcpy(&verify_data[address], value, length);
+        return wear_leveling_write(address, value, length);
+    }
+
+    // Each single-byte write below 64 generates exactly one 2-byte write log entry
+    static wear_leveling_status_t test_write_entries(std::uint32_t count) {
+        wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+        for (std::uint32_t i = 0; i < count && status == WEAR_LEVELING_SUCCESS; ++i, ++write_counter) {
+            uint8_t value = 0x80 + (write_counter & 0x7F);
+            status        = test_write(write_counter % WEAR_LEVELING_LOGICAL_SIZE, &value, sizeof(value));
+        }
+        return status;
+    }
+
+    static void verify_after_reinit(void) {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+            EXPECT_EQ(readback[i], verify_data[i]) << "Readback for address " << i << " did not match";
+        }
+    }
+
+    static std::uint32_t last_write_address(void) {
+        auto& inst = MockBackingStore::Instance();
+        return (inst.log_end() - 1)->address;
+    }
+};
+
+std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> WearLevelingIncremental::verify_data;
+std::uint32_t                                        WearLevelingIncremental::write_counter;
+
+// Erase each block of the other bank, write each chunk of consolidated data, then commit
+static constexpr std::uint32_t CONSOLIDATION_STEPS = (WEAR_LEVELING_BANK_SIZE / BACKING_STORE_ERASE_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_INCREMENTAL_WRITE_CHUNK) + 1;
+// Number of log entries before incremental consolidation begins, and before the log is full
+static constexpr std::uint32_t ENTRIES_BEFORE_RESERVE = ((WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_START) - WEAR_LEVELING_INCREMENTAL_LOG_RESERVE) / BACKING_STORE_WRITE_SIZE;
+static constexpr std::uint32_t ENTRIES_BEFORE_FULL    = (WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_START) / BACKING_STORE_WRITE_SIZE;
+
+/**
+ * This test verifies that the write log of the first bank is used after initialisation.
+ */
+TEST_F(WearLevelingIncremental, FirstWriteOccursInFirstBank) {
+    auto& inst = MockBackingStore::Instance();
+    EXPECT_EQ(test_write_entries(1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(inst.log_begin()->address, WEAR_LEVELING_LOG_START) << "Invalid first write address.";
+}
+
+/**
+ * This test verifies that consolidation only starts once the log reserve is reached, and is performed one step at a time
+ * without erasing the whole backing store.
+ */
+TEST_F(WearLevelingIncremental, ConsolidationIsIncremental) {
+    auto& inst = MockBackingStore::Instance();
+
+    EXPECT_EQ(test_write_entries(ENTRIES_BEFORE_RESERVE - 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    EXPECT_EQ(inst.erase_block_invoke_count(), 0) << "Consolidation should not have started yet";
+
+    EXPECT_EQ(test_write_entries(1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    for (std::uint32_t i = 0; i < CONSOLIDATION_STEPS - 1; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status at step " << i;
+    }
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_CONSOLIDATED) << "Final step should have committed";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should be idle after committing";
+
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Whole backing store should not have been erased";
+    EXPECT_EQ(inst.erase_block_invoke_count(), WEAR_LEVELING_BANK_SIZE / BACKING_STORE_ERASE_SIZE) << "Only the other bank should have been erased";
+
+    // Subsequent writes go to the second bank's write log
+    EXPECT_EQ(test_write_entries(1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(last_write_address(), WEAR_LEVELING_BANK_SIZE + WEAR_LEVELING_LOG_START) << "Write should have occurred in the second bank";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that writes made while consolidation is in progress are retained, whether or not the modified data
+ * has already been copied.
+ */
+TEST_F(WearLevelingIncremental, WritesDuringConsolidationRetained) {
+    EXPECT_EQ(test_write_entries(ENTRIES_BEFORE_RESERVE), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    // Erase the other bank, then copy the first chunk
+    for (std::uint32_t i = 0; i < (WEAR_LEVELING_BANK_SIZE / BACKING_STORE_ERASE_SIZE) + 1; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+
+    uint8_t value = 0x11;
+    EXPECT_EQ(test_write(0, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    value = 0x22;
+    EXPECT_EQ(test_write(WEAR_LEVELING_LOGICAL_SIZE - 1, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_task();
+    } while (status == WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Consolidation should have completed";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that losing power before the commit leaves the previous bank active and intact.
+ */
+TEST_F(WearLevelingIncremental, InterruptedConsolidationKeepsPreviousBank) {
+    EXPECT_EQ(test_write_entries(ENTRIES_BEFORE_RESERVE), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    for (std::uint32_t i = 0; i < CONSOLIDATION_STEPS - 1; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+
+    verify_after_reinit();
+
+    EXPECT_EQ(test_write_entries(1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_LT(last_write_address(), WEAR_LEVELING_BANK_SIZE) << "Write should have occurred in the first bank";
+}
+
+/**
+ * This test verifies that a failed commit leaves the previous bank active and intact.
+ */
+TEST_F(WearLevelingIncremental, FailedCommitKeepsPreviousBank) {
+    auto& inst = MockBackingStore::Instance();
+
+    EXPECT_EQ(test_write_entries(ENTRIES_BEFORE_RESERVE), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    for (std::uint32_t i = 0; i < CONSOLIDATION_STEPS - 1; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+
+    inst.set_write_callback([](std::uint64_t count, std::uint32_t address) { return address != WEAR_LEVELING_BANK_SIZE + WEAR_LEVELING_LOGICAL_SIZE; });
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Commit should have failed";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that filling the write log before incremental consolidation completes forces consolidation in-line,
+ * still without erasing the active bank.
+ */
+TEST_F(WearLevelingIncremental, LogFullConsolidatesInline) {
+    auto& inst = MockBackingStore::Instance();
+
+    EXPECT_EQ(test_write_entries(ENTRIES_BEFORE_FULL - 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(test_write_entries(1), WEAR_LEVELING_CONSOLIDATED) << "Write should have forced consolidation";
+
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Whole backing store should not have been erased";
+    EXPECT_EQ(inst.erase_block_invoke_count(), WEAR_LEVELING_BANK_SIZE / BACKING_STORE_ERASE_SIZE) << "Only the other bank should have been erased";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that repeated consolidation alternates between banks, always selecting the newest on startup.
+ */
+TEST_F(WearLevelingIncremental, ConsolidationAlternatesBanks) {
+    for (int bank = 1; bank <= 4; ++bank) {
+        // The log holds at most one entry from the previous iteration, so the last of these fills it
+        EXPECT_EQ(test_write_entries(ENTRIES_BEFORE_FULL - 2), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        EXPECT_EQ(test_write_entries(2), WEAR_LEVELING_CONSOLIDATED) << "Write should have forced consolidation";
+
+        verify_after_reinit();
+
+        EXPECT_EQ(test_write_entries(1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        EXPECT_EQ(last_write_address(), (bank % 2) * WEAR_LEVELING_BANK_SIZE + WEAR_LEVELING_LOG_START) << "Write occurred in the wrong bank";
+    }
+
+    verify_after_reinit();
+}
@@ -0,0 +1,163 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingWriteBack : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+static wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+    memcpy(&verify_data[address], value, length);
+    return wear_leveling_write(address, value, length);
+}
+
+static void verify_after_reinit(void) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+        EXPECT_EQ(readback[i], verify_data[i]) << "Readback for address " << i << " did not match";
+    }
+}
+
+/**
+ * This test verifies that writes only touch the cache until a flush is requested.
+ */
+TEST_F(WearLevelingWriteBack, WritesDeferredUntilFlush) {
+    auto& inst = MockBackingStore::Instance();
+    verify_data.fill(0);
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(test_write(0x02, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_TRUE(wear_leveling_has_pending_writes()) << "Write should have been queued";
+
+    EXPECT_EQ(inst.unlock_invoke_count(), 0) << "Unlock should not have been invoked";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should not have been invoked";
+    EXPECT_EQ(inst.lock_invoke_count(), 0) << "Lock should not have been invoked";
+
+    test_val = 0;
+    EXPECT_EQ(wear_leveling_read(0x02, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(test_val, 0x14) << "Readback should come from cache before flush";
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_FALSE(wear_leveling_has_pending_writes()) << "Flush should have cleared the queue";
+    EXPECT_EQ(inst.unlock_invoke_count(), 1) << "Unlock should have been invoked once";
+    EXPECT_EQ(inst.write_invoke_count(), 1) << "Write should have been invoked once";
+    EXPECT_EQ(inst.lock_invoke_count(), 1) << "Lock should have been invoked once";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that repeated writes to the same location result in a single write log entry.
+ */
+TEST_F(WearLevelingWriteBack, RepeatedWritesCoalesced) {
+    auto& inst = MockBackingStore::Instance();
+    verify_data.fill(0);
+
+    for (uint8_t i = 0x10; i < 0x20; ++i) {
+        EXPECT_EQ(test_write(0x03, &i, sizeof(i)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), 1) << "Write should have been invoked once";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that a flush with nothing queued does not touch the backing store.
+ */
+TEST_F(WearLevelingWriteBack, EmptyFlushNoInvocations) {
+    auto& inst = MockBackingStore::Instance();
+
+    EXPECT_FALSE(wear_leveling_has_pending_writes()) << "Nothing should be queued after init";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.unlock_invoke_count(), 0) << "Unlock should not have been invoked";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should not have been invoked";
+    EXPECT_EQ(inst.lock_invoke_count(), 0) << "Lock should not have been invoked";
+}
+
+/**
+ * This test verifies that exceeding the number of pending ranges merges ranges rather than losing data.
+ */
+TEST_F(WearLevelingWriteBack, RangeOverflowMerges) {
+    verify_data.fill(0);
+
+    for (uint32_t address = 0; address < WEAR_LEVELING_LOGICAL_SIZE; address += 3) {
+        uint8_t test_val = 0x40 + address;
+        EXPECT_EQ(test_write(address, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_FALSE(wear_leveling_has_pending_writes()) << "Flush should have cleared the queue";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that a flush which fills the write log consolidates, and that all data survives.
+ */
+TEST_F(WearLevelingWriteBack, FlushConsolidates) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    EXPECT_EQ(test_write(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+
+    std::iota(testvalue.begin(), testvalue.end(), 0x60);
+    EXPECT_EQ(test_write(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_CONSOLIDATED) << "Flush returned incorrect status";
+    EXPECT_FALSE(wear_leveling_has_pending_writes()) << "Flush should have cleared the queue";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that pending writes are retained after a failed flush, and written on a subsequent flush.
+ */
+TEST_F(WearLevelingWriteBack, FailedFlushRetained) {
+    auto& inst = MockBackingStore::Instance();
+    verify_data.fill(0);
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(test_write(0x04, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    inst.set_write_callback([](std::uint64_t count, std::uint32_t address) { return false; });
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_FAILED) << "Flush should have failed";
+    EXPECT_TRUE(wear_leveling_has_pending_writes()) << "Failed flush should retain queued writes";
+
+    inst.set_write_callback([](std::uint64_t count, std::uint32_t address) { return true; });
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_FALSE(wear_leveling_has_pending_writes()) << "Flush should have cleared the queue";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that an erase discards any queued writes.
+ */
+TEST_F(WearLevelingWriteBack, EraseDiscardsPending) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write(0x04, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase returned incorrect status";
+    EXPECT_FALSE(wear_leveling_has_pending_writes()) << "Erase should have cleared the queue";
+
+    uint64_t write_count = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), write_count) << "Write should not have been invoked";
+
+    verify_data.fill(0);
+    verify_after_reinit();
+}
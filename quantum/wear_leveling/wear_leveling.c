@@ -76,12 +76,45 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        During writes, with WEAR_LEVELING_WRITE_BACK:
+            * The cache is updated with the new data.
+            * The modified byte range is merged into a small set of pending
+                ranges -- overlapping or adjacent ranges are coalesced, and if
+                the set is full the new range is merged with its nearest
+                neighbour.
+            * On flush, each pending range is appended to the write log from
+                the cache, meaning repeated writes to the same location only
+                result in a single log entry.
+
+        Consolidation, with WEAR_LEVELING_INCREMENTAL_CONSOLIDATION:
+            * The backing store is split into two equally-sized banks, each
+                containing its own consolidated data, hash, generation counter
+                and write log. The valid bank with the highest generation is
+                the active bank.
+            * Once the active write log has less than
+                WEAR_LEVELING_INCREMENTAL_LOG_RESERVE bytes remaining, the other
+                bank is erased one BACKING_STORE_ERASE_SIZE block at a time,
+                then the cache is written one WEAR_LEVELING_INCREMENTAL_WRITE_CHUNK
+                at a time, each step driven by wear_leveling_task().
+            * Log entries appended after the other bank has been erased are
+                written to both banks' write logs.
+            * Finally, the incremented generation counter and then the hash
+                are written, atomically switching the active bank. Until then
+                the previous bank remains valid, so power loss at any point
+                during consolidation does not lose data.
+            * If the active write log fills before this completes, the
+                consolidation is restarted and run to completion in-line.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
         of the consolidated data area, in an attempt to detect and guard against
         any data corruption.
 
+        With WEAR_LEVELING_INCREMENTAL_CONSOLIDATION, the hash is followed by
+        the 8-byte generation counter of the bank, and the hash covers both the
+        consolidated data and the generation counter.
+
         The write log follows the hash:
 
         Given that the algorithm needs to cater for 2-, 4-, and 8-byte writes,
@@ -162,8 +195,93 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    uint32_t bank_base;
+    uint64_t generation;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Incremental consolidation: phases
+ */
+typedef enum wear_leveling_background_state_t { BACKGROUND_IDLE = 0, BACKGROUND_ERASING, BACKGROUND_WRITING, BACKGROUND_COMMITTING } wear_leveling_background_state_t;
+
+/**
+ * Incremental consolidation: progress into the inactive bank
+ */
+static struct {
+    wear_leveling_background_state_t state;
+    uint32_t                         bank_base;     // base address of the bank being consolidated into
+    uint32_t                         offset;        // progress through the current phase
+    uint32_t                         write_address; // next write log location in the bank being consolidated into
+    uint64_t                         hash;          // FNV1a_64 of the consolidated data written so far
+} wear_leveling_background;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+#ifdef WEAR_LEVELING_WRITE_BACK
+/**
+ * Logical byte range [start, end) which has been modified in the cache but not yet written to the backing store.
+ */
+typedef struct wear_leveling_range_t {
+    uint32_t start;
+    uint32_t end;
+} wear_leveling_range_t;
+
+/**
+ * Storage area for the pending write-back ranges, kept disjoint and non-adjacent.
+ */
+static struct {
+    wear_leveling_range_t ranges[(WEAR_LEVELING_WRITE_BACK_RANGES)];
+    uint8_t               count;
+} wear_leveling_pending;
+
+/**
+ * Adds the supplied range to the pending set, coalescing with any existing ranges it touches.
+ */
+static void wear_leveling_pending_add(uint32_t start, uint32_t end) {
+    // Absorb any ranges which overlap or abut the new range
+    uint8_t i = 0;
+    while (i < wear_leveling_pending.count) {
+        wear_leveling_range_t *r = &wear_leveling_pending.ranges[i];
+        if (r->start <= end && start <= r->end) {
+            start = (r->start < start) ? r->start : start;
+            end   = (r->end > end) ? r->end : end;
+            *r    = wear_leveling_pending.ranges[--wear_leveling_pending.count];
+            continue;
+        }
+        ++i;
+    }
+
+    if (wear_leveling_pending.count < (WEAR_LEVELING_WRITE_BACK_RANGES)) {
+        wear_leveling_pending.ranges[wear_leveling_pending.count++] = (wear_leveling_range_t){.start = start, .end = end};
+        return;
+    }
+
+    // No free slots -- widen the nearest range to cover the new one. Ranges are disjoint, so nothing else can lie in the gap.
+    uint8_t  nearest     = 0;
+    uint32_t nearest_gap = UINT32_MAX;
+    for (i = 0; i < wear_leveling_pending.count; ++i) {
+        const wear_leveling_range_t *r   = &wear_leveling_pending.ranges[i];
+        const uint32_t               gap = (r->end < start) ? (start - r->end) : (r->start - end);
+        if (gap < nearest_gap) {
+            nearest     = i;
+            nearest_gap = gap;
+        }
+    }
+    wear_leveling_range_t *r = &wear_leveling_pending.ranges[nearest];
+    r->start                 = (r->start < start) ? r->start : start;
+    r->end                   = (r->end > end) ? r->end : end;
+}
+
+/**
+ * Discards all pending ranges.
+ */
+static inline void wear_leveling_pending_clear(void) {
+    wear_leveling_pending.count = 0;
+}
+#endif // WEAR_LEVELING_WRITE_BACK
+
 /**
  * Locking helper: status
  */
@@ -197,14 +315,114 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
     return STATUS_SUCCESS;
 }
 
+/**
+ * Translates an address within the active bank to a backing store address.
+ */
+static inline uint32_t wear_leveling_bank_address(uint32_t address) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    return wear_leveling.bank_base + address;
+#else
+    return address;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+}
+
+/**
+ * Reads a 64-bit value, such as the FNV1a_64 of the consolidated data, from the backing store.
+ */
+static bool wear_leveling_read_u64(uint32_t address, uint64_t *value) {
+    write_log_entry_t entry;
+    bool              ok;
+#if BACKING_STORE_WRITE_SIZE == 2
+    ok = backing_store_read_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    ok = backing_store_read_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    ok = backing_store_read(address, &entry.raw64);
+#endif
+    *value = entry.raw64;
+    return ok;
+}
+
+/**
+ * Writes a 64-bit value, such as the FNV1a_64 of the consolidated data, to the backing store.
+ */
+static bool wear_leveling_write_u64(uint32_t address, uint64_t value) {
+    write_log_entry_t entry;
+    entry.raw64 = value;
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry.raw64);
+#endif
+}
+
 /**
  * Resets the cache, ensuring the write address is correctly initialised.
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_START); // skips the FNV1a_64 (and generation counter) of the consolidated buffer
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    wear_leveling.bank_base        = 0;
+    wear_leveling.generation       = 0;
+    wear_leveling_background.state = BACKGROUND_IDLE;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#ifdef WEAR_LEVELING_WRITE_BACK
+    wear_leveling_pending_clear();
+#endif // WEAR_LEVELING_WRITE_BACK
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Reads the consolidated data from the newest valid bank of the backing store into the cache, selecting it as the active bank.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+    wl_dprintf("Reading consolidated data\n");
+
+    // An erased or never-committed bank reads back a generation of zero
+    uint64_t generation[2] = {0, 0};
+    wear_leveling_read_u64((WEAR_LEVELING_LOGICAL_SIZE) + 8, &generation[0]);
+    wear_leveling_read_u64((WEAR_LEVELING_BANK_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &generation[1]);
+
+    // Prefer the newest bank, falling back to the other if the newest failed to commit
+    const uint8_t          newest = (generation[1] > generation[0]) ? 1 : 0;
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint8_t i = 0; i < 2; ++i) {
+        const uint8_t  bank      = i == 0 ? newest : (1 - newest);
+        const uint32_t bank_base = bank * (WEAR_LEVELING_BANK_SIZE);
+        if (generation[bank] == 0) {
+            continue;
+        }
+
+        if (!backing_store_read_bulk(bank_base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+            wl_dprintf("Failed to read from backing store\n");
+            status = WEAR_LEVELING_FAILED;
+            break;
+        }
+
+        // Verify the FNV1a_64 result, which covers the generation counter as well
+        uint64_t expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+        expected          = fnv_64a_buf(&generation[bank], sizeof(generation[bank]), expected);
+        uint64_t actual   = 0;
+        wl_dprintf("Reading checksum\n");
+        wear_leveling_read_u64(bank_base + (WEAR_LEVELING_LOGICAL_SIZE), &actual);
+        if (actual == expected) {
+            wl_dprintf("Checksum matches, consolidated data is correct\n");
+            wear_leveling.bank_base  = bank_base;
+            wear_leveling.generation = generation[bank];
+            return WEAR_LEVELING_SUCCESS;
+        }
+    }
+
+    // No valid bank, so clear the cache and start afresh with the first bank -- caters for the completely clean MCU case.
+    wl_dprintf("No valid consolidated data, clearing cache\n");
+    wear_leveling_clear_cache();
+    return status;
+}
+#else
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -220,19 +438,13 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
 
     // Verify the FNV1a_64 result
     if (status != WEAR_LEVELING_FAILED) {
-        uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        write_log_entry_t entry;
+        uint64_t expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+        uint64_t actual   = 0;
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_u64((WEAR_LEVELING_LOGICAL_SIZE), &actual);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
-        if (entry.raw64 == expected) {
+        if (actual == expected) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
@@ -265,35 +477,109 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
 
     if (status != WEAR_LEVELING_FAILED) {
         // Write out the FNV1a_64 result of the consolidated data
-        write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
+        if (!wear_leveling_write_u64((WEAR_LEVELING_LOGICAL_SIZE), fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT))) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        wear_leveling_lock();
+    }
+    return status;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Incremental consolidation: begins consolidation into the inactive bank.
+ */
+static void wear_leveling_background_start(void) {
+    wl_dprintf("Starting incremental consolidation\n");
+    wear_leveling_background.state         = BACKGROUND_ERASING;
+    wear_leveling_background.bank_base     = (wear_leveling.bank_base == 0) ? (WEAR_LEVELING_BANK_SIZE) : 0;
+    wear_leveling_background.offset        = 0;
+    wear_leveling_background.write_address = (WEAR_LEVELING_LOG_START);
+    wear_leveling_background.hash          = FNV1A_64_INIT;
+}
+
+/**
+ * Incremental consolidation: performs a single erase, write, or commit operation.
+ * Pre-condition: the backing store is unlocked.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED if the inactive bank was committed and is now active
+ */
+static wear_leveling_status_t wear_leveling_background_step(void) {
+    switch (wear_leveling_background.state) {
+        case BACKGROUND_ERASING:
+            if (!backing_store_erase_block(wear_leveling_background.bank_base + wear_leveling_background.offset)) {
+                wl_dprintf("Failed to erase backing store\n");
                 break;
             }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
+            wear_leveling_background.offset += (BACKING_STORE_ERASE_SIZE);
+            if (wear_leveling_background.offset >= (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling_background.state  = BACKGROUND_WRITING;
+                wear_leveling_background.offset = 0;
+            }
+            return WEAR_LEVELING_SUCCESS;
+
+        case BACKGROUND_WRITING: {
+            const uint32_t offset = wear_leveling_background.offset;
+            const uint32_t length = ((WEAR_LEVELING_LOGICAL_SIZE) - offset) < (WEAR_LEVELING_INCREMENTAL_WRITE_CHUNK) ? ((WEAR_LEVELING_LOGICAL_SIZE) - offset) : (WEAR_LEVELING_INCREMENTAL_WRITE_CHUNK);
+            if (!backing_store_write_bulk(wear_leveling_background.bank_base + offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / sizeof(backing_store_int_t))) {
+                wl_dprintf("Failed to write consolidated data\n");
                 break;
             }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
+            // Hash exactly what was written -- later modifications of this chunk are mirrored into the new write log
+            wear_leveling_background.hash = fnv_64a_buf(&wear_leveling.cache[offset], length, wear_leveling_background.hash);
+            wear_leveling_background.offset += length;
+            if (wear_leveling_background.offset >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling_background.state = BACKGROUND_COMMITTING;
+            }
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case BACKGROUND_COMMITTING: {
+            // The generation counter is written first, then the FNV1a_64 -- the bank only becomes valid once the checksum is written
+            uint64_t generation = wear_leveling.generation + 1;
+            uint64_t hash       = fnv_64a_buf(&generation, sizeof(generation), wear_leveling_background.hash);
+            wl_dprintf("Committing consolidated data\n");
+            if (!wear_leveling_write_u64(wear_leveling_background.bank_base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, generation) || !wear_leveling_write_u64(wear_leveling_background.bank_base + (WEAR_LEVELING_LOGICAL_SIZE), hash)) {
+                wl_dprintf("Failed to write checksum\n");
                 break;
             }
-#endif
-        } while (0);
-    }
+            wear_leveling.bank_base        = wear_leveling_background.bank_base;
+            wear_leveling.generation       = generation;
+            wear_leveling.write_address    = wear_leveling_background.write_address;
+            wear_leveling_background.state = BACKGROUND_IDLE;
+            return WEAR_LEVELING_CONSOLIDATED;
+        }
 
-    if (lock_status == STATUS_SUCCESS) {
-        wear_leveling_lock();
+        default:
+            return WEAR_LEVELING_SUCCESS;
     }
-    return status;
+
+    // Abandon this attempt, it'll be restarted from scratch
+    wear_leveling_background.state = BACKGROUND_IDLE;
+    return WEAR_LEVELING_FAILED;
 }
 
+/**
+ * Forces a write of the current cache into the inactive bank, restarting any in-progress incremental consolidation.
+ * The active bank is left untouched until the new bank is committed, so power loss during this operation does not lose data.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    // Restart from scratch, as entries logged while this runs in-line are not mirrored
+    wear_leveling_background_start();
+
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_background_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+
+    return status;
+}
+#else
 /**
  * Forces a write of the current cache.
  * Erases the backing store, including the write log.
@@ -316,10 +602,11 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_START); // skips the FNV1a_64 of the consolidated area
 
     return status;
 }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Potential write of the current cache to the backing store.
@@ -329,10 +616,17 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= (WEAR_LEVELING_BANK_SIZE)) {
         return wear_leveling_consolidate_force();
     }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Start consolidating into the other bank early enough that it can complete in the background
+    if (wear_leveling_background.state == BACKGROUND_IDLE && ((WEAR_LEVELING_BANK_SIZE) - wear_leveling.write_address) <= (WEAR_LEVELING_INCREMENTAL_LOG_RESERVE)) {
+        wear_leveling_background_start();
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     return WEAR_LEVELING_SUCCESS;
 }
 
@@ -342,12 +636,32 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value) {
-    bool ok = backing_store_write(wear_leveling.write_address, value);
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // A previous consolidation failed and the log is still full -- retry, which persists the cache in its entirety.
+    if (wear_leveling.write_address >= (WEAR_LEVELING_BANK_SIZE)) {
+        return wear_leveling_consolidate_force();
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+    bool ok = backing_store_write(wear_leveling_bank_address(wear_leveling.write_address), value);
     if (!ok) {
         wl_dprintf("Failed to write to backing store\n");
         return WEAR_LEVELING_FAILED;
     }
     wear_leveling.write_address += (BACKING_STORE_WRITE_SIZE);
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Once the inactive bank has been erased, mirror entries into its write log so modifications to already-copied data aren't lost
+    if (wear_leveling_background.state == BACKGROUND_WRITING || wear_leveling_background.state == BACKGROUND_COMMITTING) {
+        if (wear_leveling_background.write_address >= (WEAR_LEVELING_BANK_SIZE) || !backing_store_write(wear_leveling_background.bank_base + wear_leveling_background.write_address, value)) {
+            wl_dprintf("Failed to mirror write log entry, abandoning incremental consolidation\n");
+            wear_leveling_background.state = BACKGROUND_IDLE;
+        } else {
+            wear_leveling_background.write_address += (BACKING_STORE_WRITE_SIZE);
+        }
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     return wear_leveling_consolidate_if_needed();
 }
 
@@ -477,10 +791,10 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = (WEAR_LEVELING_LOG_START); // skips the FNV1a_64 (and generation counter) of the consolidated area
+    while (!cancel_playback && address < (WEAR_LEVELING_BANK_SIZE)) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = backing_store_read(wear_leveling_bank_address(address), &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +823,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = backing_store_read(wear_leveling_bank_address(address), &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +843,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = backing_store_read(wear_leveling_bank_address(address), &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +853,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = backing_store_read(wear_leveling_bank_address(address), &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +864,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = backing_store_read(wear_leveling_bank_address(address), &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -691,6 +1005,12 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+#ifdef WEAR_LEVELING_WRITE_BACK
+    // Defer the backing store write until the next flush
+    wear_leveling_pending_add(address, address + (uint32_t)length);
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_WRITE_BACK
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -726,6 +1046,102 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+/**
+ * Writes any queued modifications into the backing store.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+#ifdef WEAR_LEVELING_WRITE_BACK
+    if (wear_leveling_pending.count == 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Flush %d range(s)\n", (int)wear_leveling_pending.count);
+
+    // Unlock the backing store once for the whole batch
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // Pending ranges are written straight out of the cache, which already holds the latest values
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint8_t i = 0; i < wear_leveling_pending.count && status == WEAR_LEVELING_SUCCESS; ++i) {
+        const wear_leveling_range_t *r = &wear_leveling_pending.ranges[i];
+        status                         = wear_leveling_write_raw(r->start, &wear_leveling.cache[r->start], r->end - r->start);
+    }
+
+    switch (status) {
+        case WEAR_LEVELING_CONSOLIDATED:
+            // Consolidation wrote the entire cache, so every pending range is now persisted.
+            wear_leveling_pending_clear();
+            break;
+
+        case WEAR_LEVELING_SUCCESS:
+            wear_leveling_pending_clear();
+            // Consolidate the cache + write log if required
+            status = wear_leveling_consolidate_if_needed();
+            break;
+
+        default:
+            // Leave the pending ranges intact so that a subsequent flush can retry.
+            status = WEAR_LEVELING_FAILED;
+            break;
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_WRITE_BACK
+}
+
+/**
+ * Determines whether or not there are queued modifications.
+ */
+bool wear_leveling_has_pending_writes(void) {
+#ifdef WEAR_LEVELING_WRITE_BACK
+    return wear_leveling_pending.count > 0;
+#else
+    return false;
+#endif // WEAR_LEVELING_WRITE_BACK
+}
+
+/**
+ * Performs a single step of any in-progress incremental consolidation.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    if (wear_leveling_background.state == BACKGROUND_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_background_step();
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+}
+
 /**
  * Reads logical data from the cache.
  */
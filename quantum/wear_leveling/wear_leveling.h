@@ -1,6 +1,7 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -36,6 +37,9 @@ wear_leveling_status_t wear_leveling_erase(void);
  * determine if an overwrite should occur -- if there is any data mismatch the entire block will be written to the log,
  * not just the changed bytes.
  *
+ * If `WEAR_LEVELING_WRITE_BACK` is defined, only the cache is updated and the modified range is queued -- the backing
+ * store is not touched until `wear_leveling_flush()` is invoked.
+ *
  * @param address[in] the logical address to write data
  * @param value[in] pointer to the source buffer
  * @param length[in] length of the data
@@ -52,3 +56,30 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Writes any queued modifications into the backing store.
+ *
+ * Only has an effect if `WEAR_LEVELING_WRITE_BACK` is defined, otherwise writes are always performed immediately.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
+
+/**
+ * Determines whether or not there are queued modifications that have not yet been written to the backing store.
+ *
+ * @return true if `wear_leveling_flush()` has work to do
+ */
+bool wear_leveling_has_pending_writes(void);
+
+/**
+ * Performs a single step of any in-progress incremental consolidation.
+ *
+ * Only has an effect if `WEAR_LEVELING_INCREMENTAL_CONSOLIDATION` is defined, and should be invoked periodically so
+ * that consolidation completes before the write log is full. Each invocation performs at most one block erase, one
+ * chunk write, or the final commit.
+ *
+ * @return Status of the request -- `WEAR_LEVELING_CONSOLIDATED` once the consolidated data has been committed
+ */
+wear_leveling_status_t wear_leveling_task(void);
@@ -27,6 +27,31 @@ typedef uint64_t backing_store_int_t;
 #    error WEAR_LEVELING_LOGICAL_SIZE was not set.
 #endif
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#    ifndef BACKING_STORE_ERASE_SIZE
+#        error BACKING_STORE_ERASE_SIZE was not set, incremental consolidation requires a backing store capable of erasing individual blocks.
+#    endif
+// Backing store is split into two banks, each with consolidated data, FNV1a_64, generation counter, then write log
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + 16)
+#    ifndef WEAR_LEVELING_INCREMENTAL_LOG_RESERVE
+#        define WEAR_LEVELING_INCREMENTAL_LOG_RESERVE (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_START)) / 2)
+#    endif
+#    ifndef WEAR_LEVELING_INCREMENTAL_WRITE_CHUNK
+#        define WEAR_LEVELING_INCREMENTAL_WRITE_CHUNK 64
+#    endif
+#else
+// Backing store is a single bank with consolidated data, FNV1a_64, then write log
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#    define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + 8)
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+#ifdef WEAR_LEVELING_WRITE_BACK
+#    ifndef WEAR_LEVELING_WRITE_BACK_RANGES
+#        define WEAR_LEVELING_WRITE_BACK_RANGES 8
+#    endif
+#endif // WEAR_LEVELING_WRITE_BACK
+
 #ifdef WEAR_LEVELING_DEBUG_OUTPUT
 #    include <debug.h>
 #    define bs_dprintf(...) dprintf("Backing store: " __VA_ARGS__)
@@ -65,6 +90,15 @@ typedef uint64_t backing_store_int_t;
 _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+_Static_assert(WEAR_LEVELING_BANK_SIZE % BACKING_STORE_ERASE_SIZE == 0, "Each half of the backing size must be a multiple of the erase size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE > WEAR_LEVELING_LOG_START, "Each half of the backing size must have space for the logical size, its metadata, and a write log");
+_Static_assert(WEAR_LEVELING_INCREMENTAL_LOG_RESERVE <= (WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_START), "Incremental consolidation log reserve must fit in the write log");
+_Static_assert(WEAR_LEVELING_INCREMENTAL_WRITE_CHUNK % BACKING_STORE_WRITE_SIZE == 0, "Incremental consolidation write chunk must be a multiple of write size");
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#ifdef WEAR_LEVELING_WRITE_BACK
+_Static_assert(WEAR_LEVELING_WRITE_BACK_RANGES > 0 && WEAR_LEVELING_WRITE_BACK_RANGES <= 255, "Write-back range count must be between 1 and 255");
+#endif // WEAR_LEVELING_WRITE_BACK
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
@@ -75,6 +109,9 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_block(uint32_t address); // erases BACKING_STORE_ERASE_SIZE bytes starting at the supplied address
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Helper type used to contain a write log entry.
@@ -0,0 +1,35 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ws2812_framebuffer.h"
+#include <string.h>
+#include "timer.h"
+
+rgb_led_t ws2812_framebuffer[WS2812_LED_COUNT];
+bool      ws2812_framebuffer_dirty = false;
+
+static uint16_t last_flush = 0;
+
+void ws2812_framebuffer_write(uint16_t index, const rgb_led_t *leds, uint16_t count) {
+    if (index >= WS2812_LED_COUNT) return;
+    if (count > WS2812_LED_COUNT - index) count = WS2812_LED_COUNT - index;
+
+    if (memcmp(&ws2812_framebuffer[index], leds, count * sizeof(rgb_led_t)) != 0) {
+        memcpy(&ws2812_framebuffer[index], leds, count * sizeof(rgb_led_t));
+        ws2812_framebuffer_dirty = true;
+    }
+}
+
+void ws2812_framebuffer_flush(void) {
+    last_flush = timer_read();
+    if (ws2812_framebuffer_dirty) {
+        ws2812_framebuffer_dirty = false;
+        ws2812_setleds(ws2812_framebuffer, WS2812_LED_COUNT);
+    }
+}
+
+void ws2812_framebuffer_task(void) {
+    if (ws2812_framebuffer_dirty && timer_elapsed(last_flush) >= WS2812_FRAMEBUFFER_FLUSH_LIMIT) {
+        ws2812_framebuffer_flush();
+    }
+}
@@ -0,0 +1,55 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ws2812.h"
+
+/* When rgblight and RGB Matrix both drive WS2812 LEDs, they share one chain.
+ * Each of them renders into its own region of a single frame buffer, and the
+ * whole chain is sent once per frame instead of once per subsystem.
+ *
+ * By default the per-key LEDs come first on the chain, followed by the
+ * underglow; define WS2812_RGBLIGHT_FIRST if the underglow comes first.
+ */
+
+#if defined(RGBLIGHT_SPLIT) || defined(RGB_MATRIX_SPLIT)
+#    error "A WS2812 chain shared by rgblight and RGB Matrix isn't supported on split keyboards"
+#endif
+
+#ifndef WS2812_FRAMEBUFFER_FLUSH_LIMIT
+// limits how often changes of the underglow alone are sent, in ms
+#    define WS2812_FRAMEBUFFER_FLUSH_LIMIT 16
+#endif
+
+#ifdef WS2812_RGBLIGHT_FIRST
+#    define WS2812_RGBLIGHT_OFFSET 0
+#    define WS2812_RGB_MATRIX_OFFSET RGBLED_NUM
+#else
+#    define WS2812_RGB_MATRIX_OFFSET 0
+#    define WS2812_RGBLIGHT_OFFSET RGB_MATRIX_LED_COUNT
+#endif
+
+extern rgb_led_t ws2812_framebuffer[WS2812_LED_COUNT];
+extern bool      ws2812_framebuffer_dirty;
+
+/**
+ * @brief Copies `count` LEDs into the frame buffer, starting at `index` on
+ * the chain. Nothing is sent until the next flush.
+ */
+void ws2812_framebuffer_write(uint16_t index, const rgb_led_t *leds, uint16_t count);
+
+/**
+ * @brief Sends the whole chain, if anything changed since it was last sent.
+ */
+void ws2812_framebuffer_flush(void);
+
+/**
+ * @brief Sends changes nobody flushed, at most every
+ * WS2812_FRAMEBUFFER_FLUSH_LIMIT ms. RGB Matrix flushes each frame it renders,
+ * which sends changes of the underglow along with it; this covers the
+ * underglow changing while RGB Matrix is idle.
+ */
+void ws2812_framebuffer_task(void);
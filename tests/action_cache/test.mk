@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Run the basic tests again with the action cache
+SRC += \
+	tests/basic/test_action_layer.cpp \
+	tests/basic/test_keypress.cpp \
+	tests/basic/test_one_shot_keys.cpp \
+	tests/basic/test_tapping.cpp
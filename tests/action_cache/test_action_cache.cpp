@@ -0,0 +1,69 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "action.h"
+#include "keycode_config.h"
+}
+
+class ActionCache : public TestFixture {
+   protected:
+    void TearDown() override {
+        keymap_config.raw = eeconfig_read_keymap();
+    }
+};
+
+TEST_F(ActionCache, CollidingKeycodesResolveToTheirOwnAction) {
+    // All of these share a slot of the cache
+    const uint16_t keycodes[] = {KC_A, KC_A + ACTION_CACHE_SIZE, KC_A + 2 * ACTION_CACHE_SIZE};
+
+    for (int round = 0; round < 2; round++) {
+        for (uint16_t keycode : keycodes) {
+            EXPECT_EQ(action_for_keycode(keycode).code, ACTION_KEY(keycode));
+        }
+    }
+    EXPECT_EQ(action_for_keycode(LT(1, KC_A)).code, ACTION_LAYER_TAP_KEY(1, KC_A));
+    EXPECT_EQ(action_for_keycode(KC_A).code, ACTION_KEY(KC_A));
+    EXPECT_EQ(action_for_keycode(KC_NO).code, ACTION_NO);
+    EXPECT_EQ(action_for_keycode(KC_TRNS).code, ACTION_TRANSPARENT);
+}
+
+TEST_F(ActionCache, ChangingKeymapConfigFlushesTheCache) {
+    EXPECT_EQ(action_for_keycode(KC_LALT).code, ACTION_KEY(KC_LALT));
+    EXPECT_EQ(action_for_keycode(LALT_T(KC_ESC)).code, ACTION_MODS_TAP_KEY(MOD_LALT, KC_ESC));
+
+    keymap_config.swap_lalt_lgui = true;
+    EXPECT_EQ(action_for_keycode(KC_LALT).code, ACTION_KEY(KC_LGUI));
+    EXPECT_EQ(action_for_keycode(LALT_T(KC_ESC)).code, ACTION_MODS_TAP_KEY(MOD_LGUI, KC_ESC));
+
+    keymap_config.swap_lalt_lgui = false;
+    EXPECT_EQ(action_for_keycode(KC_LALT).code, ACTION_KEY(KC_LALT));
+}
+
+TEST_F(ActionCache, SwappedModifierIsSentAfterCachedPress) {
+    TestDriver driver;
+    KeymapKey  alt_key = KeymapKey(0, 0, 0, KC_LALT);
+
+    set_keymap({alt_key});
+
+    EXPECT_REPORT(driver, (KC_LALT));
+    alt_key.press();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    alt_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    keymap_config.swap_lalt_lgui = true;
+
+    EXPECT_REPORT(driver, (KC_LGUI));
+    alt_key.press();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    alt_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -20,6 +20,10 @@
 #include "keyboard_report_util.hpp"
 #include "test_common.hpp"
 
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
 namespace {
 
 class AudioTest : public TestFixture {
@@ -27,6 +31,21 @@ class AudioTest : public TestFixture {
     uint16_t infer_tempo() {
         return audio_ms_to_duration(1875) / 2;
     }
+
+    template <size_t N>
+    void play_song(musical_note_t (&song)[N]) {
+        // PLAY_SONG relies on C converting to a pointer to an array of unknown size
+        audio_play_melody(reinterpret_cast<musical_note_t(*)[]>(&song), N, false);
+    }
+
+    // Steps the melody by `ms` and returns the frequency playing then
+    float play_for(uint16_t ms) {
+        for (uint16_t i = 0; i < ms; i++) {
+            advance_time(1);
+            audio_update_state();
+        }
+        return audio_get_frequency(0);
+    }
 };
 
 TEST_F(AudioTest, OnOffToggle) {
@@ -115,4 +134,29 @@ TEST_F(AudioTest, BpmConversion) {
     }
 }
 
+TEST_F(AudioTest, PlayMelody) {
+    static musical_note_t song[] = SONG(Q__NOTE(_C4), E__NOTE(_E4), E__NOTE(_E4), M__NOTE(_A4, 255));
+    const float           tol    = 1.0f / 8;
+
+    audio_on();
+    audio_set_tempo(120);
+    play_song(song);
+    EXPECT_TRUE(audio_is_playing_melody());
+    // At 120 bpm, a quarter note is 125 ms and an eighth note 62 ms
+    EXPECT_NEAR(audio_get_frequency(0), NOTE_C4, tol);
+    EXPECT_NEAR(play_for(124), NOTE_C4, tol);
+    EXPECT_NEAR(play_for(1), NOTE_E4, tol);
+    EXPECT_NEAR(play_for(61), NOTE_E4, tol);
+    // Repeated notes are separated by a short rest
+    EXPECT_NEAR(play_for(1), NOTE_REST, tol);
+    EXPECT_NEAR(play_for(15), NOTE_E4, tol);
+    EXPECT_NEAR(play_for(62), NOTE_A4, tol);
+    EXPECT_NEAR(play_for(1991), NOTE_A4, tol);
+    play_for(1);
+    EXPECT_FALSE(audio_is_playing_melody());
+
+    audio_stop_all();
+    audio_off();
+}
+
 } // namespace
@@ -0,0 +1,7 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUDIO_ENABLE = yes
+
+# Run the audio tests again against precompiled songs
+SRC += tests/audio/test_audio.cpp
@@ -0,0 +1,47 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+namespace {
+
+class AudioCompactSongs : public TestFixture {};
+
+TEST_F(AudioCompactSongs, NotesAreThreeBytes) {
+    static musical_note_t song[] = SONG(STARTUP_SOUND);
+
+    EXPECT_EQ(sizeof(musical_note_t), 3);
+    EXPECT_EQ(sizeof(song), NOTE_ARRAY_SIZE(song) * 3);
+}
+
+TEST_F(AudioCompactSongs, PitchIsRounded) {
+    static musical_note_t song[] = SONG(Q__NOTE(_REST), Q__NOTE(_C0), Q__NOTE(_A4), Q__NOTE(_B8), M__NOTE(_C4, 255));
+
+    EXPECT_EQ(MUSICAL_NOTE_PITCH(song[0]), 0);
+    EXPECT_EQ(MUSICAL_NOTE_PITCH(song[1]), 131);
+    EXPECT_EQ(MUSICAL_NOTE_PITCH(song[2]), 3520);
+    EXPECT_EQ(MUSICAL_NOTE_PITCH(song[3]), 63217);
+    for (const musical_note_t& note : song) {
+        EXPECT_NEAR(MUSICAL_NOTE_PITCH_HZ(note), MUSICAL_NOTE_PITCH(note) / 8.0f, 1e-3);
+    }
+    EXPECT_EQ(MUSICAL_NOTE_DURATION(song[0]), 16);
+    EXPECT_EQ(MUSICAL_NOTE_DURATION(song[4]), 255);
+}
+
+TEST_F(AudioCompactSongs, DurationIsClamped) {
+    musical_note_t note;
+
+    MUSICAL_NOTE_SET(note, NOTE_A4, 300);
+    EXPECT_EQ(MUSICAL_NOTE_PITCH(note), 3520);
+    EXPECT_EQ(MUSICAL_NOTE_DURATION(note), 255);
+}
+
+TEST_F(AudioCompactSongs, SongDurationIsClamped) {
+    static musical_note_t song[] = SONG(M__NOTE(_A4, 300), M__NOTE(_A4, 4 * 64));
+
+    EXPECT_EQ(MUSICAL_NOTE_DURATION(song[0]), 255);
+    EXPECT_EQ(MUSICAL_NOTE_DURATION(song[1]), 255);
+}
+
+} // namespace
@@ -0,0 +1,39 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark.hpp"
+#include "keycode.h"
+#include "quantum.h"
+#include "test_common.h"
+#include "typing_layout.hpp"
+
+class BenchmarkCombo : public BenchmarkFixture {
+   protected:
+    // The first three rows of a QWERTY layout, the combos of
+    // test_benchmark_combos.c are spread over all of them
+    std::vector<KeymapKey> typing_keys() {
+        std::vector<KeymapKey> keys = typing_layout();
+        for (auto& key : keys) {
+            add_key(key);
+        }
+        return keys;
+    }
+};
+
+TEST_F(BenchmarkCombo, typing_with_combos) {
+    auto result = run_typing(typing_keys());
+
+    EXPECT_GT(result.reports, 0);
+    if (result.allocations >= 0) EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(BenchmarkCombo, fast_rolls_with_combos) {
+    TypingStream stream;
+    stream.rollover = 3;
+    stream.max_gap  = 10;
+
+    auto result = run_typing(typing_keys(), stream);
+
+    EXPECT_GT(result.reports, 0);
+    if (result.allocations >= 0) EXPECT_EQ(result.allocations, 0);
+}
@@ -0,0 +1,24 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { esc_combo, tab_combo, bspc_combo, ent_combo, lsft_combo, three_key_combo };
+
+uint16_t const esc_keys[]       = {KC_Q, KC_W, COMBO_END};
+uint16_t const tab_keys[]       = {KC_A, KC_S, COMBO_END};
+uint16_t const bspc_keys[]      = {KC_O, KC_P, COMBO_END};
+uint16_t const ent_keys[]       = {KC_L, KC_SCLN, COMBO_END};
+uint16_t const lsft_keys[]      = {KC_F, KC_J, COMBO_END};
+uint16_t const three_key_keys[] = {KC_X, KC_C, KC_V, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [esc_combo]       = COMBO(esc_keys, KC_ESC),
+    [tab_combo]       = COMBO(tab_keys, KC_TAB),
+    [bspc_combo]      = COMBO(bspc_keys, KC_BSPC),
+    [ent_combo]       = COMBO(ent_keys, KC_ENT),
+    [lsft_combo]      = COMBO(lsft_keys, OSM(MOD_LSFT)),
+    [three_key_combo] = COMBO(three_key_keys, KC_CAPS)
+};
+// clang-format on
@@ -0,0 +1,8 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+KEY_OVERRIDE_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = test_benchmark_key_overrides.c
+
+SRC += tests/test_common/benchmark.cpp tests/test_common/typing_layout.cpp
@@ -0,0 +1,37 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark.hpp"
+#include "keycode.h"
+#include "quantum.h"
+#include "test_common.h"
+#include "typing_layout.hpp"
+
+class BenchmarkKeyOverride : public BenchmarkFixture {
+   protected:
+    // Letters, the keys overridden in test_benchmark_key_overrides.c and the
+    // modifiers that trigger them
+    std::vector<KeymapKey> typing_keys() {
+        std::vector<KeymapKey> keys = typing_layout({
+            KeymapKey(0, 0, 0, KC_ESC),
+            KeymapKey(0, 9, 0, KC_BSPC),
+            KeymapKey(0, 9, 1, KC_LSFT),
+            KeymapKey(0, 0, 2, KC_LCTL),
+            KeymapKey(0, 9, 2, KC_RSFT),
+        });
+        for (auto& key : keys) {
+            add_key(key);
+        }
+        return keys;
+    }
+};
+
+TEST_F(BenchmarkKeyOverride, typing_with_key_overrides) {
+    TypingStream stream;
+    stream.rollover = 3;
+
+    auto result = run_typing(typing_keys(), stream);
+
+    EXPECT_GT(result.reports, 0);
+    if (result.allocations >= 0) EXPECT_EQ(result.allocations, 0);
+}
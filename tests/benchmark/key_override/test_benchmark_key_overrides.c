@@ -0,0 +1,23 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+const key_override_t shift_bspc_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t shift_esc_override  = ko_make_basic(MOD_MASK_SHIFT, KC_ESC, KC_GRV);
+const key_override_t shift_comm_override = ko_make_basic(MOD_MASK_SHIFT, KC_COMM, KC_SCLN);
+const key_override_t shift_dot_override  = ko_make_basic(MOD_MASK_SHIFT, KC_DOT, KC_COLN);
+const key_override_t ctrl_h_override     = ko_make_basic(MOD_MASK_CTRL, KC_H, KC_LEFT);
+const key_override_t ctrl_l_override     = ko_make_basic(MOD_MASK_CTRL, KC_L, KC_RGHT);
+
+// clang-format off
+const key_override_t **key_overrides = (const key_override_t *[]){
+    &shift_bspc_override,
+    &shift_esc_override,
+    &shift_comm_override,
+    &shift_dot_override,
+    &ctrl_h_override,
+    &ctrl_l_override,
+    NULL
+};
+// clang-format on
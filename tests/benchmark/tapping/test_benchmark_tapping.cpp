@@ -0,0 +1,55 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark.hpp"
+#include "keycode.h"
+#include "quantum.h"
+#include "test_common.h"
+#include "typing_layout.hpp"
+
+class BenchmarkTapping : public BenchmarkFixture {
+   protected:
+    // Maps every position of the first three rows on layers 0 and 1, with
+    // `layer0` overriding some of the plain letters of layer 0
+    std::vector<KeymapKey> typing_keys(std::initializer_list<KeymapKey> layer0 = {}) {
+        std::vector<KeymapKey> keys = typing_layout(layer0);
+        for (uint8_t i = 0; i < keys.size(); i++) {
+            add_key(keys[i]);
+            add_key(KeymapKey(1, keys[i].position.col, keys[i].position.row, i < 10 ? KC_1 + i : KC_TRNS));
+        }
+        return keys;
+    }
+};
+
+TEST_F(BenchmarkTapping, plain_keys) {
+    auto result = run_typing(typing_keys());
+
+    EXPECT_GT(result.reports, 0);
+    if (result.allocations >= 0) EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(BenchmarkTapping, home_row_mod_taps) {
+    auto result = run_typing(typing_keys({
+        KeymapKey(0, 0, 1, LGUI_T(KC_A)),
+        KeymapKey(0, 1, 1, LALT_T(KC_S)),
+        KeymapKey(0, 2, 1, LCTL_T(KC_D)),
+        KeymapKey(0, 3, 1, LSFT_T(KC_F)),
+        KeymapKey(0, 6, 1, RSFT_T(KC_J)),
+        KeymapKey(0, 7, 1, RCTL_T(KC_K)),
+        KeymapKey(0, 8, 1, RALT_T(KC_L)),
+        KeymapKey(0, 9, 1, RGUI_T(KC_SCLN)),
+    }));
+
+    EXPECT_GT(result.reports, 0);
+    if (result.allocations >= 0) EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(BenchmarkTapping, layer_taps) {
+    auto result = run_typing(typing_keys({
+        KeymapKey(0, 4, 2, LT(1, KC_B)),
+        KeymapKey(0, 5, 2, LT(1, KC_N)),
+    }));
+
+    EXPECT_GT(result.reports, 0);
+    if (result.allocations >= 0) EXPECT_EQ(result.allocations, 0);
+}
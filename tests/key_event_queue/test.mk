@@ -0,0 +1,11 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+KEY_EVENT_QUEUE_ENABLE = yes
+
+# Run the basic tests again through the queue
+SRC += \
+	tests/basic/test_action_layer.cpp \
+	tests/basic/test_keypress.cpp \
+	tests/basic/test_one_shot_keys.cpp \
+	tests/basic/test_tapping.cpp
@@ -0,0 +1,129 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "key_event_queue.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::InSequence;
+
+class KeyEventQueue : public TestFixture {
+   protected:
+    // key_event() uses designated initializers out of order, which C++ doesn't allow
+    keyevent_t key_event(uint8_t row, uint8_t col, bool pressed) {
+        return {{col, row}, timer_read(), KEY_EVENT, pressed};
+    }
+};
+
+TEST_F(KeyEventQueue, EventsComeOutInOrderUntilFull) {
+    keyevent_t event;
+
+    for (uint8_t i = 0; i < KEY_EVENT_QUEUE_SIZE - 1; i++) {
+        EXPECT_TRUE(key_event_queue_push(key_event(i, 0, true)));
+    }
+    EXPECT_FALSE(key_event_queue_push(key_event(7, 0, true)));
+
+    for (uint8_t i = 0; i < KEY_EVENT_QUEUE_SIZE - 1; i++) {
+        ASSERT_TRUE(key_event_queue_pop(&event, NULL));
+        EXPECT_EQ(event.key.row, i);
+    }
+    EXPECT_FALSE(key_event_queue_pop(&event, NULL));
+}
+
+TEST_F(KeyEventQueue, ChangesThatDontFitAreQueuedByTheNextScan) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b = KeymapKey(0, 1, 0, KC_B);
+    KeymapKey  key_c = KeymapKey(0, 2, 0, KC_C);
+    KeymapKey  key_d = KeymapKey(0, 3, 0, KC_D);
+    KeymapKey  key_e = KeymapKey(0, 4, 0, KC_E);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    key_d.press();
+    key_e.press();
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E));
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_C, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_d.release();
+    key_e.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, EventsKeepTheTimeOfTheScan) {
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    keyevent_t event;
+
+    set_keymap({key_a});
+
+    advance_time(5);
+    key_a.press();
+    uint16_t scan_time = timer_read();
+    EXPECT_TRUE(matrix_scan_events());
+    // a slow main loop, nothing takes the event off the queue meanwhile
+    advance_time(TAPPING_TERM + 50);
+
+    ASSERT_TRUE(key_event_queue_pop(&event, NULL));
+    EXPECT_EQ(event.time, scan_time);
+    EXPECT_EQ(event.key.row, 0);
+    EXPECT_EQ(event.key.col, 0);
+    EXPECT_TRUE(event.pressed);
+    EXPECT_FALSE(key_event_queue_pop(&event, NULL));
+
+    key_a.release();
+    EXPECT_TRUE(matrix_scan_events());
+    ASSERT_TRUE(key_event_queue_pop(&event, NULL));
+    EXPECT_FALSE(event.pressed);
+}
+
+TEST_F(KeyEventQueue, TapHoldFollowsTheTimeOfTheScan) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_A));
+
+    set_keymap({mod_tap_key});
+
+    // pressed for TAPPING_TERM + 50 by the time the main loop gets to it
+    mod_tap_key.press();
+    EXPECT_TRUE(matrix_scan_events());
+    advance_time(TAPPING_TERM + 50);
+
+    // a hold, timed from the scan; timed from the processing it would become a tap
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
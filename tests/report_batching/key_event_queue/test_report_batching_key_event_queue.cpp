@@ -0,0 +1,68 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "key_event_queue.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class ReportBatchingKeyEventQueue : public TestFixture {};
+
+TEST_F(ReportBatchingKeyEventQueue, FastRollKeepsItsOrder) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_s = KeymapKey(0, 1, 0, KC_S);
+    KeymapKey  key_d = KeymapKey(0, 2, 0, KC_D);
+
+    set_keymap({key_a, key_s, key_d});
+
+    // six scans are queued before the main loop gets to them
+    key_a.press();
+    EXPECT_TRUE(matrix_scan_events());
+    key_s.press();
+    EXPECT_TRUE(matrix_scan_events());
+    key_a.release();
+    EXPECT_TRUE(matrix_scan_events());
+    key_d.press();
+    EXPECT_TRUE(matrix_scan_events());
+    key_s.release();
+    EXPECT_TRUE(matrix_scan_events());
+    key_d.release();
+    EXPECT_TRUE(matrix_scan_events());
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_S));
+    EXPECT_REPORT(driver, (KC_S));
+    EXPECT_REPORT(driver, (KC_S, KC_D));
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatchingKeyEventQueue, ChordOfOneScanIsSentInOneReport) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_s = KeymapKey(0, 1, 0, KC_S);
+
+    set_keymap({key_a, key_s});
+
+    key_a.press();
+    key_s.press();
+    EXPECT_TRUE(matrix_scan_events());
+    key_a.release();
+    key_s.release();
+    EXPECT_TRUE(matrix_scan_events());
+
+    EXPECT_REPORT(driver, (KC_A, KC_S));
+    EXPECT_EMPTY_REPORT(driver);
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+}
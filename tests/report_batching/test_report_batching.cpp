@@ -0,0 +1,176 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t* record) {
+    if (keycode == QK_USER_0 && record->event.pressed) {
+        tap_code(KC_CAPS);
+        return false;
+    }
+    return true;
+}
+
+class ReportBatching : public TestFixture {};
+
+TEST_F(ReportBatching, ChordIsSentInOneReport) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_s = KeymapKey(0, 1, 0, KC_S);
+    KeymapKey  key_d = KeymapKey(0, 0, 1, KC_D);
+
+    set_keymap({key_a, key_s, key_d});
+
+    EXPECT_REPORT(driver, (KC_A, KC_S, KC_D));
+    key_a.press();
+    key_s.press();
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_s.release();
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, PressAndReleaseInOneScanAreSentApart) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_s = KeymapKey(0, 1, 0, KC_S);
+
+    set_keymap({key_a, key_s});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The release of A must not be merged with the press of S
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_S));
+    key_a.release();
+    key_s.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_s.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, ModifierBeforeKeyIsMerged) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    KeymapKey  key_a     = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key_shift, key_a});
+
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    key_shift.press();
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, ModifierAfterKeyIsSentApart) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a     = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_shift = KeymapKey(0, 1, 0, KC_LSFT);
+
+    set_keymap({key_a, key_shift});
+
+    // A is processed first, so the host has to see it unshifted first
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_LSFT));
+    key_a.press();
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, TapWithinOneEventIsNotLost) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_mod_tap = KeymapKey(0, 0, 0, LSFT_T(KC_A));
+
+    set_keymap({key_mod_tap});
+
+    EXPECT_NO_REPORT(driver);
+    key_mod_tap.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The tap is pressed and released while processing the release
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    key_mod_tap.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, TapCodeIsNotMergedAway) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_caps = KeymapKey(0, 0, 0, QK_USER_0);
+
+    set_keymap({key_caps});
+
+    // Releasing a key the batch still holds back sends its press first
+    EXPECT_REPORT(driver, (KC_CAPS));
+    EXPECT_EMPTY_REPORT(driver);
+    key_caps.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_caps.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, KeyboardReportIsSentBeforeConsumerReport) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a    = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_volu = KeymapKey(0, 1, 0, KC_AUDIO_VOL_UP);
+
+    set_keymap({key_a, key_volu});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_CALL(driver, send_extra_mock(_));
+    key_a.press();
+    key_volu.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_extra_mock(_));
+    key_a.release();
+    key_volu.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,107 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "test_rgb_matrix_driver.h"
+
+// How long each render step takes, on the mocked timer
+static uint8_t test_step_ms = 0;
+
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    wait_ms(test_step_ms);
+    return true;
+}
+}
+
+class RgbMatrixAdaptiveBudget : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        test_step_ms = 0;
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        // Settle on fast frames with no typing, whatever the previous test left behind
+        idle_for(RGB_MATRIX_ADAPTIVE_IDLE_TIME * 3);
+    }
+
+    // The process limit is the width of each LED range
+    uint8_t process_limit(void) {
+        struct rgb_matrix_limits_t limits = rgb_matrix_get_limits(0);
+        return limits.led_max_index - limits.led_min_index;
+    }
+
+    // Runs for the given number of task runs, checking the process limit stays within its bounds
+    uint32_t flushes_in(uint32_t ms) {
+        uint32_t flushes = test_rgb_matrix_flushes;
+        for (uint32_t i = 0; i < ms; i += 10) {
+            idle_for(10);
+            EXPECT_GE(process_limit(), 1);
+            EXPECT_LE(process_limit(), RGB_MATRIX_LED_COUNT);
+        }
+        return test_rgb_matrix_flushes - flushes;
+    }
+};
+
+TEST_F(RgbMatrixAdaptiveBudget, FastStepsDrawEveryLed) {
+    EXPECT_EQ(process_limit(), RGB_MATRIX_LED_COUNT);
+}
+
+TEST_F(RgbMatrixAdaptiveBudget, SlowStepsShrinkProcessLimit) {
+    // Well over RGB_MATRIX_ADAPTIVE_STEP_LIMIT, whatever the number of LEDs in a step
+    test_step_ms = 2;
+    flushes_in(2000);
+
+    EXPECT_EQ(process_limit(), 1);
+}
+
+TEST_F(RgbMatrixAdaptiveBudget, FastStepsGrowProcessLimitBack) {
+    test_step_ms = 2;
+    flushes_in(2000);
+    ASSERT_EQ(process_limit(), 1);
+
+    test_step_ms = 0;
+    flushes_in(2000);
+
+    EXPECT_EQ(process_limit(), RGB_MATRIX_LED_COUNT);
+}
+
+TEST_F(RgbMatrixAdaptiveBudget, IdleFlushesAtMinimumInterval) {
+    uint32_t flushes = flushes_in(1000);
+
+    EXPECT_LE(flushes, 1000 / RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MIN + 1);
+    // Each frame also spends a few task runs starting, rendering and flushing
+    EXPECT_GE(flushes, 1000 / (RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MIN + 4));
+}
+
+TEST_F(RgbMatrixAdaptiveBudget, TypingFlushesAtMaximumInterval) {
+    KeymapKey key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_ANY_REPORT(driver).Times(2);
+    tap_key(key_a);
+    uint32_t flushes = flushes_in(RGB_MATRIX_ADAPTIVE_IDLE_TIME / 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_LE(flushes, RGB_MATRIX_ADAPTIVE_IDLE_TIME / 2 / RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MAX + 1);
+
+    // Once idle, the interval shortens back to the minimum
+    flushes_in(RGB_MATRIX_ADAPTIVE_IDLE_TIME * 2);
+    flushes = flushes_in(1000);
+    EXPECT_GE(flushes, 1000 / (RGB_MATRIX_ADAPTIVE_FLUSH_LIMIT_MIN + 4));
+}
+
+TEST_F(RgbMatrixAdaptiveBudget, SlowFramesLengthenInterval) {
+    test_step_ms = 5;
+    flushes_in(2000);
+    ASSERT_EQ(process_limit(), 1);
+
+    // One LED per step, so a frame takes four steps and the interval is at least twice that
+    uint32_t start   = timer_read32();
+    uint32_t flushes = flushes_in(2000);
+    EXPECT_LE(flushes, timer_elapsed32(start) / (2 * RGB_MATRIX_LED_COUNT * test_step_ms) + 1);
+}
@@ -0,0 +1,119 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "test_rgb_matrix_driver.h"
+#include "lib/lib8tion/lib8tion.h"
+
+static bool               test_overlay = false;
+static RGB                test_overlay_color;
+static uint8_t            test_overlay_alpha;
+static rgb_matrix_blend_t test_overlay_blend;
+
+bool rgb_matrix_indicators_user(void) {
+    if (test_overlay) {
+        rgb_matrix_set_color_blend(0, test_overlay_color.r, test_overlay_color.g, test_overlay_color.b, test_overlay_alpha, test_overlay_blend);
+    }
+    return true;
+}
+}
+
+class RgbMatrixCompositor : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        test_overlay = false;
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        // Grey, so the base is the same whatever the hue has drifted to
+        rgb_matrix_sethsv_noeeprom(0, 0, 200);
+        idle_for(RGB_MATRIX_COMPOSITOR_BASE_INTERVAL * 2);
+        base = test_rgb_matrix_leds[0].r;
+    }
+
+    void overlay(uint8_t r, uint8_t g, uint8_t b, uint8_t alpha, rgb_matrix_blend_t blend) {
+        test_overlay         = true;
+        test_overlay_color.r = r;
+        test_overlay_color.g = g;
+        test_overlay_color.b = b;
+        test_overlay_alpha   = alpha;
+        test_overlay_blend   = blend;
+        idle_for(100);
+    }
+
+    uint8_t base;
+};
+
+static void expect_led(uint8_t i, uint8_t r, uint8_t g, uint8_t b) {
+    EXPECT_EQ(test_rgb_matrix_leds[i].r, r) << "LED " << +i;
+    EXPECT_EQ(test_rgb_matrix_leds[i].g, g) << "LED " << +i;
+    EXPECT_EQ(test_rgb_matrix_leds[i].b, b) << "LED " << +i;
+}
+
+TEST_F(RgbMatrixCompositor, OpaqueOverlayReplacesBase) {
+    overlay(0, 100, 250, 255, RGB_MATRIX_BLEND_NORMAL);
+
+    expect_led(0, 0, 100, 250);
+    expect_led(1, base, base, base);
+}
+
+TEST_F(RgbMatrixCompositor, AlphaBlendsWithBase) {
+    overlay(0, 100, 250, 128, RGB_MATRIX_BLEND_NORMAL);
+
+    expect_led(0, blend8(base, 0, 128), blend8(base, 100, 128), blend8(base, 250, 128));
+    EXPECT_LT(test_rgb_matrix_leds[0].r, base);
+    EXPECT_GT(test_rgb_matrix_leds[0].b, base);
+    expect_led(1, base, base, base);
+}
+
+TEST_F(RgbMatrixCompositor, AddBrightensBase) {
+    overlay(20, 100, 250, 128, RGB_MATRIX_BLEND_ADD);
+
+    expect_led(0, qadd8(base, scale8(20, 128)), qadd8(base, scale8(100, 128)), qadd8(base, scale8(250, 128)));
+    EXPECT_GT(test_rgb_matrix_leds[0].r, base);
+    expect_led(1, base, base, base);
+}
+
+TEST_F(RgbMatrixCompositor, MultiplyDarkensBase) {
+    overlay(0, 128, 255, 255, RGB_MATRIX_BLEND_MULTIPLY);
+    expect_led(0, blend8(base, 0, 255), blend8(base, scale8(base, 128), 255), blend8(base, scale8(base, 255), 255));
+    EXPECT_EQ(test_rgb_matrix_leds[0].r, 0);
+
+    overlay(0, 128, 255, 128, RGB_MATRIX_BLEND_MULTIPLY);
+    expect_led(0, blend8(base, 0, 128), blend8(base, scale8(base, 128), 128), blend8(base, scale8(base, 255), 128));
+    EXPECT_LT(test_rgb_matrix_leds[0].g, base);
+    expect_led(1, base, base, base);
+}
+
+TEST_F(RgbMatrixCompositor, RemovedOverlayRevealsBase) {
+    overlay(0, 100, 250, 255, RGB_MATRIX_BLEND_NORMAL);
+    expect_led(0, 0, 100, 250);
+
+    test_overlay = false;
+    idle_for(100);
+
+    expect_led(0, base, base, base);
+}
+
+// The base effect is only re-rendered every RGB_MATRIX_COMPOSITOR_BASE_INTERVAL,
+// while overlays keep being composed over it every frame
+TEST_F(RgbMatrixCompositor, BaseHeldBetweenRenders) {
+    // Restarting the effect re-renders the base straight away and restarts the interval
+    rgb_matrix_disable_noeeprom();
+    idle_for(100);
+    rgb_matrix_enable_noeeprom();
+    idle_for(50);
+    expect_led(1, base, base, base);
+
+    rgb_matrix_sethsv_noeeprom(0, 0, 100);
+    overlay(0, 100, 250, 255, RGB_MATRIX_BLEND_NORMAL);
+    expect_led(0, 0, 100, 250);
+    expect_led(1, base, base, base);
+
+    idle_for(RGB_MATRIX_COMPOSITOR_BASE_INTERVAL);
+    expect_led(0, 0, 100, 250);
+    EXPECT_LT(test_rgb_matrix_leds[1].r, base);
+}
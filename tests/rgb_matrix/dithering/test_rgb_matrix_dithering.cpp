@@ -0,0 +1,61 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "test_rgb_matrix_driver.h"
+}
+
+class RgbMatrixDithering : public TestFixture {
+   protected:
+    TestDriver driver;
+};
+
+// A level between two 8-bit steps is sent as the steps either side of it,
+// alternating from frame to frame so the average comes out at the level
+TEST_F(RgbMatrixDithering, FractionAlternatesAndAverages) {
+    const uint8_t frames = 8;
+    uint16_t      sum[3] = {0, 0, 0};
+    bool          seen_low[3] = {false, false, false}, seen_high[3] = {false, false, false};
+
+    for (uint8_t frame = 0; frame < frames; frame++) {
+        // 16.5, 16.25 and 32.0
+        rgb_matrix_set_color16(0, 0x1080, 0x1040, 0x2000);
+        rgb_matrix_update_pwm_buffers();
+
+        uint8_t out[3] = {test_rgb_matrix_leds[0].r, test_rgb_matrix_leds[0].g, test_rgb_matrix_leds[0].b};
+        for (uint8_t c = 0; c < 2; c++) {
+            EXPECT_TRUE(out[c] == 16 || out[c] == 17) << "frame " << +frame << " channel " << +c << " was " << +out[c];
+            seen_low[c] |= out[c] == 16;
+            seen_high[c] |= out[c] == 17;
+        }
+        EXPECT_EQ(out[2], 32) << "frame " << +frame;
+        for (uint8_t c = 0; c < 3; c++) {
+            sum[c] += out[c];
+        }
+    }
+
+    for (uint8_t c = 0; c < 2; c++) {
+        EXPECT_TRUE(seen_low[c] && seen_high[c]) << "channel " << +c << " never alternated";
+    }
+    EXPECT_EQ(sum[0], 16 * frames + frames / 2);
+    EXPECT_EQ(sum[1], 16 * frames + frames / 4);
+    EXPECT_EQ(sum[2], 32 * frames);
+}
+
+// Half a step comes out as strictly alternating frames
+TEST_F(RgbMatrixDithering, HalfStepAlternatesEveryFrame) {
+    rgb_matrix_set_color16(1, 0x4080, 0x4080, 0x4080);
+    rgb_matrix_update_pwm_buffers();
+    uint8_t last = test_rgb_matrix_leds[1].r;
+
+    for (uint8_t frame = 0; frame < 6; frame++) {
+        rgb_matrix_set_color16(1, 0x4080, 0x4080, 0x4080);
+        rgb_matrix_update_pwm_buffers();
+        uint8_t out = test_rgb_matrix_leds[1].r;
+
+        EXPECT_EQ(out + last, 0x40 + 0x41) << "frame " << +frame;
+        last = out;
+    }
+}
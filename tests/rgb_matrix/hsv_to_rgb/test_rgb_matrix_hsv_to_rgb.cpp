@@ -0,0 +1,139 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "led_tables.h"
+#include "test_rgb_matrix_driver.h"
+
+static bool test_override = false;
+
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    RGB rgb = hsv_to_rgb(hsv);
+    if (test_override) {
+        rgb.r = 1;
+        rgb.g = 2;
+        rgb.b = 3;
+    }
+    return rgb;
+}
+}
+
+// RGB is laid out in the byte order of the WS2812, so it is filled in field by field
+static RGB make_rgb(uint8_t r, uint8_t g, uint8_t b) {
+    RGB rgb;
+    rgb.r = r;
+    rgb.g = g;
+    rgb.b = b;
+    return rgb;
+}
+
+// The six region switch hsv_to_rgb() used before the table driven kernel
+static RGB reference_hsv_to_rgb(HSV hsv, bool use_cie) {
+    uint16_t v = use_cie ? pgm_read_byte(&CIE1931_CURVE[hsv.v]) : hsv.v;
+    if (hsv.s == 0) {
+        return make_rgb((uint8_t)v, (uint8_t)v, (uint8_t)v);
+    }
+
+    uint16_t h         = hsv.h;
+    uint16_t s         = hsv.s;
+    uint8_t  region    = h * 6 / 255;
+    uint8_t  remainder = (h * 2 - region * 85) * 3;
+    uint8_t  p         = (v * (255 - s)) >> 8;
+    uint8_t  q         = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    uint8_t  t         = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+    switch (region) {
+        case 6:
+        case 0:
+            return make_rgb((uint8_t)v, t, p);
+        case 1:
+            return make_rgb(q, (uint8_t)v, p);
+        case 2:
+            return make_rgb(p, (uint8_t)v, t);
+        case 3:
+            return make_rgb(p, q, (uint8_t)v);
+        case 4:
+            return make_rgb(t, p, (uint8_t)v);
+        default:
+            return make_rgb((uint8_t)v, p, q);
+    }
+}
+
+class RgbMatrixHsvToRgb : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        test_override = false;
+    }
+};
+
+static void expect_same_colors(const HSV *hsv, const RGB *rgb, const RGB *expected, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (rgb[i].r != expected[i].r || rgb[i].g != expected[i].g || rgb[i].b != expected[i].b) {
+            ADD_FAILURE() << "HSV " << +hsv[i].h << "," << +hsv[i].s << "," << +hsv[i].v << " gave " << +rgb[i].r << "," << +rgb[i].g << "," << +rgb[i].b << ", expected " << +expected[i].r << "," << +expected[i].g << "," << +expected[i].b;
+            return;
+        }
+    }
+}
+
+TEST_F(RgbMatrixHsvToRgb, MatchesReferenceForEveryColor) {
+    HSV hsv[256];
+    RGB rgb[256], cie[256], nocie[256], expected[256];
+
+    for (uint16_t s = 0; s < 256; s++) {
+        for (uint16_t v = 0; v < 256; v++) {
+            for (uint16_t h = 0; h < 256; h++) {
+                hsv[h] = (HSV){.h = (uint8_t)h, .s = (uint8_t)s, .v = (uint8_t)v};
+            }
+
+            hsv_to_rgb_buffer(hsv, cie, 255);
+            cie[255] = hsv_to_rgb(hsv[255]);
+            for (uint16_t h = 0; h < 256; h++) {
+                expected[h] = reference_hsv_to_rgb(hsv[h], true);
+            }
+            expect_same_colors(hsv, cie, expected, 255);
+            expect_same_colors(&hsv[255], &cie[255], &expected[255], 1);
+
+            hsv_to_rgb_buffer_nocie(hsv, nocie, 255);
+            nocie[255] = hsv_to_rgb_nocie(hsv[255]);
+            for (uint16_t h = 0; h < 256; h++) {
+                expected[h] = reference_hsv_to_rgb(hsv[h], false);
+            }
+            expect_same_colors(hsv, nocie, expected, 255);
+            expect_same_colors(&hsv[255], &nocie[255], &expected[255], 1);
+            if (HasFailure()) return;
+        }
+    }
+}
+
+// Overrides of rgb_matrix_hsv_to_rgb() (eg. current limits) still apply to the LEDs the runners queue
+TEST_F(RgbMatrixHsvToRgb, RunnersUseHsvToRgbOverride) {
+    rgb_matrix_enable_noeeprom();
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CYCLE_ALL);
+    test_override = true;
+    idle_for(100);
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(test_rgb_matrix_leds[i].r, 1) << "LED " << +i;
+        EXPECT_EQ(test_rgb_matrix_leds[i].g, 2) << "LED " << +i;
+        EXPECT_EQ(test_rgb_matrix_leds[i].b, 3) << "LED " << +i;
+    }
+}
+
+TEST_F(RgbMatrixHsvToRgb, RunnersMatchSingleConversion) {
+    rgb_matrix_enable_noeeprom();
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CYCLE_ALL);
+    rgb_matrix_sethsv_noeeprom(100, 0, 150);
+    idle_for(100);
+
+    // Without saturation the hue the effect cycles through doesn't matter
+    RGB expected = hsv_to_rgb((HSV){.h = 100, .s = 0, .v = 150});
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(test_rgb_matrix_leds[i].r, expected.r) << "LED " << +i;
+        EXPECT_EQ(test_rgb_matrix_leds[i].g, expected.g) << "LED " << +i;
+        EXPECT_EQ(test_rgb_matrix_leds[i].b, expected.b) << "LED " << +i;
+    }
+}
@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "test_rgb_matrix_driver.h"
+
+static bool test_indicator = false;
+
+bool rgb_matrix_indicators_user(void) {
+    if (test_indicator) {
+        rgb_matrix_set_color(0, 0, 0, 255);
+    }
+    return true;
+}
+}
+
+class RgbMatrixStaticFrameSkip : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        test_indicator = false;
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+        idle_for(200);
+    }
+};
+
+static void expect_led(uint8_t i, uint8_t r, uint8_t g, uint8_t b) {
+    EXPECT_EQ(test_rgb_matrix_leds[i].r, r) << "LED " << +i;
+    EXPECT_EQ(test_rgb_matrix_leds[i].g, g) << "LED " << +i;
+    EXPECT_EQ(test_rgb_matrix_leds[i].b, b) << "LED " << +i;
+}
+
+TEST_F(RgbMatrixStaticFrameSkip, StaticEffectStopsFlushing) {
+    uint32_t flushes = test_rgb_matrix_flushes;
+    idle_for(500);
+
+    EXPECT_EQ(test_rgb_matrix_flushes, flushes);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        expect_led(i, 255, 0, 0);
+    }
+}
+
+TEST_F(RgbMatrixStaticFrameSkip, ConfigChangeIsFlushed) {
+    uint32_t flushes = test_rgb_matrix_flushes;
+    rgb_matrix_sethsv_noeeprom(0, 0, 255);
+    idle_for(200);
+
+    EXPECT_GT(test_rgb_matrix_flushes, flushes);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        expect_led(i, 255, 255, 255);
+    }
+}
+
+// An indicator drawing the same every frame doesn't keep the LEDs flushing
+TEST_F(RgbMatrixStaticFrameSkip, UnchangedIndicatorStopsFlushing) {
+    test_indicator = true;
+    idle_for(200);
+    expect_led(0, 0, 0, 255);
+    expect_led(1, 255, 0, 0);
+
+    uint32_t flushes = test_rgb_matrix_flushes;
+    idle_for(500);
+
+    EXPECT_EQ(test_rgb_matrix_flushes, flushes);
+    expect_led(0, 0, 0, 255);
+    expect_led(1, 255, 0, 0);
+}
+
+TEST_F(RgbMatrixStaticFrameSkip, RemovedIndicatorRevealsEffect) {
+    test_indicator = true;
+    idle_for(200);
+    expect_led(0, 0, 0, 255);
+
+    test_indicator = false;
+    idle_for(200);
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        expect_led(i, 255, 0, 0);
+    }
+}
@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "rgb_matrix.h"
+#include "test_rgb_matrix_driver.h"
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        { 0, 1, 2, 3, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED },
+        { [0 ... MATRIX_COLS - 1] = NO_LED },
+        { [0 ... MATRIX_COLS - 1] = NO_LED },
+        { [0 ... MATRIX_COLS - 1] = NO_LED },
+    }, {
+        { 0, 0 }, { 75, 0 }, { 150, 0 }, { 224, 0 },
+    }, {
+        4, 4, 4, 4,
+    }
+};
+// clang-format on
+
+RGB        test_rgb_matrix_leds[RGB_MATRIX_LED_COUNT];
+uint32_t   test_rgb_matrix_flushes = 0;
+static RGB test_rgb_matrix_buffer[RGB_MATRIX_LED_COUNT];
+
+static void test_rgb_matrix_init(void) {}
+
+static void test_rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    test_rgb_matrix_buffer[index] = (RGB){.r = red, .g = green, .b = blue};
+}
+
+static void test_rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        test_rgb_matrix_set_color(i, red, green, blue);
+    }
+}
+
+static void test_rgb_matrix_flush(void) {
+    memcpy(test_rgb_matrix_leds, test_rgb_matrix_buffer, sizeof(test_rgb_matrix_leds));
+    test_rgb_matrix_flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = test_rgb_matrix_init,
+    .set_color     = test_rgb_matrix_set_color,
+    .set_color_all = test_rgb_matrix_set_color_all,
+    .flush         = test_rgb_matrix_flush,
+};
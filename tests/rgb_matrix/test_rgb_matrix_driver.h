@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "color.h"
+
+// What each LED shows, updated by the flush of the test driver
+extern RGB test_rgb_matrix_leds[RGB_MATRIX_LED_COUNT];
+// How many times the test driver has been flushed
+extern uint32_t test_rgb_matrix_flushes;
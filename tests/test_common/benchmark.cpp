@@ -0,0 +1,201 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark.hpp"
+#include "typing_layout.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+extern "C" {
+#include "action.h"
+#include "action_tapping.h"
+#include "debug.h"
+#include "host.h"
+#include "keyboard.h"
+#include "test_matrix.h"
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+bool     counting_allocations = false;
+uint64_t allocations          = 0;
+uint32_t reports              = 0;
+
+uint8_t benchmark_keyboard_leds(void) {
+    return 0;
+}
+
+void benchmark_send_keyboard(report_keyboard_t *report) {
+    reports++;
+}
+
+void benchmark_send_nkro(report_nkro_t *report) {
+    reports++;
+}
+
+void benchmark_send_mouse(report_mouse_t *report) {
+    reports++;
+}
+
+void benchmark_send_extra(report_extra_t *report) {
+    reports++;
+}
+
+host_driver_t benchmark_driver = {benchmark_keyboard_leds, benchmark_send_keyboard, benchmark_send_nkro, benchmark_send_mouse, benchmark_send_extra};
+
+struct StreamEvent {
+    uint8_t  key;
+    bool     pressed;
+    uint16_t gap;
+};
+
+std::vector<StreamEvent> generate_stream(size_t key_count, const TypingStream &stream, uint32_t events) {
+    std::vector<StreamEvent> result;
+    std::vector<uint8_t>     held;
+    uint32_t                 state = stream.seed ? stream.seed : 1;
+    uint16_t                 span  = stream.max_gap > stream.min_gap ? stream.max_gap - stream.min_gap + 1 : 1;
+
+    result.reserve(events + stream.rollover);
+    while (result.size() < events) {
+        uint16_t gap   = std::max<uint16_t>(1, stream.min_gap + typing_random(state) % span);
+        bool     press = held.empty() || (held.size() < stream.rollover && held.size() < key_count && (typing_random(state) & 1));
+
+        if (press) {
+            uint8_t key;
+            do {
+                key = typing_random(state) % key_count;
+            } while (std::find(held.begin(), held.end(), key) != held.end());
+            held.push_back(key);
+            result.push_back({key, true, gap});
+        } else {
+            // Release the key held the longest, as in rolling from one key to the next
+            result.push_back({held.front(), false, gap});
+            held.erase(held.begin());
+        }
+    }
+    for (uint8_t key : held) {
+        result.push_back({key, false, 1});
+    }
+    return result;
+}
+
+uint32_t stream_events(const TypingStream &stream) {
+    const char *events = std::getenv("QMK_BENCHMARK_EVENTS");
+    if (events != nullptr && std::atol(events) > 0) {
+        return std::atol(events);
+    }
+    return stream.events;
+}
+
+} // namespace
+
+#if defined(__GLIBC__)
+// Count allocations by wrapping the allocator entry points of glibc, the key
+// processing pipeline itself is expected to never allocate
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size) __THROW {
+    if (counting_allocations) allocations++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) __THROW {
+    if (counting_allocations) allocations++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) __THROW {
+    if (counting_allocations) allocations++;
+    return __libc_realloc(ptr, size);
+}
+}
+#endif
+
+double BenchmarkResult::ns_per_event() const {
+    return events ? (double)elapsed_ns / events : 0;
+}
+
+double BenchmarkResult::ns_per_scan() const {
+    return scans ? (double)elapsed_ns / scans : 0;
+}
+
+BenchmarkResult BenchmarkFixture::run_typing(const std::vector<KeymapKey> &keys, const TypingStream &stream) {
+    BenchmarkResult result = {};
+    if (keys.empty()) {
+        ADD_FAILURE() << "no keys to type";
+        return result;
+    }
+
+    std::vector<StreamEvent> events = generate_stream(keys.size(), stream, stream_events(stream));
+
+    host_driver_t *test_driver = host_get_driver();
+    uint8_t        debug_raw   = debug_config.raw;
+    host_set_driver(&benchmark_driver);
+    debug_config.raw     = 0;
+    reports              = 0;
+    allocations          = 0;
+    counting_allocations = true;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const StreamEvent &event : events) {
+        const keypos_t &position = keys[event.key].position;
+        if (event.pressed) {
+            press_key(position.col, position.row);
+        } else {
+            release_key(position.col, position.row);
+        }
+        for (uint16_t i = 0; i < event.gap; i++) {
+            keyboard_task();
+            advance_time(1);
+        }
+        result.scans += event.gap;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    counting_allocations = false;
+    result.events        = events.size();
+    result.reports       = reports;
+    result.elapsed_ns    = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+#if defined(__GLIBC__)
+    result.allocations = allocations;
+#else
+    result.allocations = -1;
+#endif
+
+    // Let anything still pending time out before the fixture checks for a quiet keyboard
+    for (uint16_t i = 0; i < TAPPING_TERM * 2; i++) {
+        keyboard_task();
+        advance_time(1);
+    }
+    host_set_driver(test_driver);
+    debug_config.raw = debug_raw;
+
+    const ::testing::TestInfo *const test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    std::stringstream                line;
+    line << std::fixed << std::setprecision(1);
+    line << "[ BENCH    ] " << test_info->test_suite_name() << "." << test_info->name() << ": " << result.events << " events, " << result.scans << " scans, " << result.reports << " reports, " << result.ns_per_event() << " ns/event, " << result.ns_per_scan() << " ns/scan, ";
+    if (result.allocations < 0) {
+        line << "allocations not counted";
+    } else {
+        line << result.allocations << " allocations";
+    }
+    std::cout << line.str() << std::endl;
+
+    RecordProperty("events", std::to_string(result.events));
+    RecordProperty("scans", std::to_string(result.scans));
+    RecordProperty("reports", std::to_string(result.reports));
+    RecordProperty("ns_per_event", std::to_string(result.ns_per_event()));
+    RecordProperty("ns_per_scan", std::to_string(result.ns_per_scan()));
+    RecordProperty("allocations", std::to_string(result.allocations));
+    return result;
+}
@@ -0,0 +1,55 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+/**
+ * @brief Shape of the synthetic typing stream driven by
+ * `BenchmarkFixture::run_typing`. The same seed always produces the same
+ * stream, so results are comparable between builds.
+ */
+struct TypingStream {
+    /** Number of key presses and releases, `QMK_BENCHMARK_EVENTS` overrides it. */
+    uint32_t events = 10000;
+    /** Most keys held down at once. */
+    uint8_t rollover = 2;
+    /** Shortest and longest time between two events, in scan loops (ms). */
+    uint16_t min_gap = 1;
+    uint16_t max_gap = 40;
+    uint32_t seed    = 1;
+};
+
+struct BenchmarkResult {
+    uint32_t events;
+    uint32_t scans;
+    uint32_t reports;
+    uint64_t elapsed_ns;
+    /** Heap allocations made while the stream ran, or -1 if they can't be counted on this host. */
+    int64_t allocations;
+
+    double ns_per_event() const;
+    double ns_per_scan() const;
+};
+
+/**
+ * @brief Test fixture that times the whole key processing pipeline, from the
+ * matrix scan to the report sent to the host, for a stream of key events.
+ *
+ * Reports go to a counting host driver rather than the gmock `TestDriver`, and
+ * debug output is turned off while the stream runs, so neither is measured.
+ * The result is printed as a `[ BENCH    ]` line and recorded as properties of
+ * the test, which end up in the gtest XML output.
+ */
+class BenchmarkFixture : public TestFixture {
+   public:
+    /**
+     * @brief Types a stream of presses and releases of `keys`, which must all
+     * be mapped, and returns how long it took.
+     */
+    BenchmarkResult run_typing(const std::vector<KeymapKey>& keys, const TypingStream& stream = {});
+};
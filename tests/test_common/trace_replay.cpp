@@ -0,0 +1,285 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "trace_replay.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include "typing_layout.hpp"
+
+extern "C" {
+#include "debug.h"
+#include "host.h"
+#include "test_matrix.h"
+#include "timer.h"
+}
+
+namespace {
+
+std::vector<TraceReport>* recorded_reports = nullptr;
+
+void record_report(TraceReport::Type type, const report_keyboard_t* keyboard) {
+    TraceReport report = {timer_read32(), type, {}};
+    if (keyboard != nullptr) {
+        report.keyboard = *keyboard;
+    }
+    recorded_reports->push_back(report);
+}
+
+uint8_t trace_keyboard_leds(void) {
+    return 0;
+}
+
+void trace_send_keyboard(report_keyboard_t* report) {
+    record_report(TraceReport::KEYBOARD, report);
+}
+
+void trace_send_nkro(report_nkro_t* report) {
+    record_report(TraceReport::NKRO, nullptr);
+}
+
+void trace_send_mouse(report_mouse_t* report) {
+    record_report(TraceReport::MOUSE, nullptr);
+}
+
+void trace_send_extra(report_extra_t* report) {
+    record_report(TraceReport::EXTRA, nullptr);
+}
+
+host_driver_t trace_driver = {trace_keyboard_leds, trace_send_keyboard, trace_send_nkro, trace_send_mouse, trace_send_extra};
+
+// Nearest-rank percentile of sorted values
+uint32_t percentile(const std::vector<uint32_t>& sorted, uint8_t percent) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = (sorted.size() * percent + 99) / 100;
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+std::map<std::string, uint32_t> latency_values(const TraceLatency& latency) {
+    return {
+        {"events", latency.events}, {"unreported", latency.unreported}, {"p50", latency.p50}, {"p90", latency.p90}, {"p99", latency.p99}, {"max", latency.max},
+    };
+}
+
+} // namespace
+
+std::vector<TraceEvent> parse_trace(std::istream& input) {
+    std::vector<TraceEvent> trace;
+    std::string             line;
+    uint32_t                line_number = 0;
+    uint32_t                console_time = 0;
+    bool                    console_started = false;
+
+    while (std::getline(input, line)) {
+        line_number++;
+        TraceEvent event;
+        char       state;
+
+        size_t console = line.find("EVENT: ");
+        if (console != std::string::npos) {
+            unsigned int key, time;
+            if (sscanf(line.c_str() + console, "EVENT: %4x%c(%u)", &key, &state, &time) != 3) {
+                ADD_FAILURE() << "trace line " << line_number << " is not a matrix event: " << line;
+                continue;
+            }
+            // Unwrap the 16-bit timer of the firmware
+            uint16_t delta = console_started ? (uint16_t)(time - (console_time & 0xFFFF)) : 0;
+            console_time   = console_started ? console_time + delta : time;
+            event.time     = console_time;
+            event.row      = key >> 8;
+            event.col      = key & 0xFF;
+            console_started = true;
+        } else {
+            size_t start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || !isdigit(line[start])) {
+                continue;
+            }
+            unsigned int time, col, row;
+            if (sscanf(line.c_str(), "%u %u %u %c", &time, &col, &row, &state) != 4) {
+                ADD_FAILURE() << "trace line " << line_number << " is not a matrix event: " << line;
+                continue;
+            }
+            event.time = time;
+            event.col  = col;
+            event.row  = row;
+        }
+
+        if ((state != 'd' && state != 'u') || event.col >= MATRIX_COLS || event.row >= MATRIX_ROWS) {
+            ADD_FAILURE() << "trace line " << line_number << " is not a matrix event: " << line;
+            continue;
+        }
+        if (!trace.empty() && event.time < trace.back().time) {
+            ADD_FAILURE() << "trace line " << line_number << " goes back in time: " << line;
+            continue;
+        }
+        event.pressed = state == 'd';
+        trace.push_back(event);
+    }
+
+    uint32_t first = trace.empty() ? 0 : trace.front().time;
+    for (TraceEvent& event : trace) {
+        event.time -= first;
+    }
+    return trace;
+}
+
+std::vector<TraceEvent> load_trace(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) {
+        ADD_FAILURE() << "can't read trace " << path;
+        return {};
+    }
+    return parse_trace(input);
+}
+
+std::vector<TraceEvent> generate_trace(const std::vector<KeymapKey>& keys, uint32_t keystrokes, uint32_t seed) {
+    std::vector<TraceEvent> trace;
+    std::vector<uint32_t>   free_at(keys.size(), 0);
+    uint32_t                state = seed ? seed : 1;
+    uint32_t                time  = 0;
+
+    trace.reserve(keystrokes * 2);
+    for (uint32_t i = 0; i < keystrokes; i++) {
+        size_t key;
+        do {
+            key = typing_random(state) % keys.size();
+        } while (free_at[key] > time);
+
+        // Each key is held for 40-139 ms and the next one follows 30-229 ms
+        // later, so quick successions roll into each other
+        uint32_t hold = 40 + typing_random(state) % 100;
+        // A key released and pressed again within the same ms is never seen released
+        free_at[key] = time + hold + 1;
+        trace.push_back({time, keys[key].position.col, keys[key].position.row, true});
+        trace.push_back({time + hold, keys[key].position.col, keys[key].position.row, false});
+        time += 30 + typing_random(state) % 200;
+    }
+
+    std::stable_sort(trace.begin(), trace.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.time < b.time; });
+    return trace;
+}
+
+TraceLatency TraceReplayFixture::replay(const std::vector<TraceEvent>& trace, uint32_t max_latency) {
+    TraceLatency          result = {};
+    std::vector<uint32_t> latencies;
+    std::vector<uint32_t> pending;
+    size_t                next_report = 0;
+
+    // Every report goes to the events before it that are still waiting for one
+    auto attribute_reports = [&]() {
+        for (; next_report < reports.size(); next_report++) {
+            for (uint32_t time : pending) {
+                uint32_t latency = reports[next_report].time - time;
+                if (latency <= max_latency) {
+                    latencies.push_back(latency);
+                } else {
+                    result.unreported++;
+                }
+            }
+            pending.clear();
+        }
+    };
+
+    reports.clear();
+    recorded_reports = &reports;
+
+    host_driver_t* test_driver = host_get_driver();
+    uint8_t        debug_raw   = debug_config.raw;
+    host_set_driver(&trace_driver);
+    debug_config.raw = 0;
+
+    uint32_t start = timer_read32();
+    for (const TraceEvent& event : trace) {
+        uint32_t elapsed = timer_read32() - start;
+        if (event.time > elapsed) {
+            idle_for(event.time - elapsed);
+        }
+        attribute_reports();
+
+        if (event.pressed) {
+            press_key(event.col, event.row);
+        } else {
+            release_key(event.col, event.row);
+        }
+        pending.push_back(timer_read32());
+    }
+    idle_for(max_latency + 1);
+    attribute_reports();
+    result.unreported += pending.size();
+
+    host_set_driver(test_driver);
+    debug_config.raw = debug_raw;
+    recorded_reports = nullptr;
+
+    std::sort(latencies.begin(), latencies.end());
+    result.events = trace.size();
+    result.p50    = percentile(latencies, 50);
+    result.p90    = percentile(latencies, 90);
+    result.p99    = percentile(latencies, 99);
+    result.max    = latencies.empty() ? 0 : latencies.back();
+    for (uint32_t latency : latencies) {
+        result.mean += latency;
+    }
+    result.mean = latencies.empty() ? 0 : result.mean / latencies.size();
+
+    const ::testing::TestInfo* const test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    std::cout << "[ LATENCY  ] " << test_info->test_suite_name() << "." << test_info->name() << ": " << result.events << " events, " << result.unreported << " unreported, p50 " << result.p50 << " ms, p90 " << result.p90 << " ms, p99 " << result.p99 << " ms, max " << result.max << " ms, mean " << std::fixed << std::setprecision(2) << result.mean << " ms" << std::endl;
+
+    for (const auto& value : latency_values(result)) {
+        RecordProperty(value.first, std::to_string(value.second));
+    }
+    return result;
+}
+
+void TraceReplayFixture::expect_latency_baseline(const TraceLatency& latency, const std::string& path, uint32_t tolerance) {
+    std::map<std::string, uint32_t> current = latency_values(latency);
+
+    const char* update = std::getenv("QMK_TRACE_UPDATE_BASELINE");
+    if (update != nullptr && strcmp(update, "0") != 0) {
+        std::ofstream output(path);
+        output << "# Latency baseline of " << ::testing::UnitTest::GetInstance()->current_test_info()->name() << ", rewrite with QMK_TRACE_UPDATE_BASELINE=1" << std::endl;
+        for (const auto& value : current) {
+            output << value.first << " " << value.second << std::endl;
+        }
+        if (!output) {
+            ADD_FAILURE() << "can't write latency baseline " << path;
+        }
+        return;
+    }
+
+    std::ifstream input(path);
+    if (!input) {
+        ADD_FAILURE() << "can't read latency baseline " << path << ", create it by running the test with QMK_TRACE_UPDATE_BASELINE=1";
+        return;
+    }
+    std::map<std::string, uint32_t> baseline;
+    std::string                     line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        std::string        name;
+        uint32_t           value;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (!(fields >> name >> value)) {
+            ADD_FAILURE() << "malformed line in latency baseline " << path << ": " << line;
+            continue;
+        }
+        baseline[name] = value;
+    }
+
+    EXPECT_EQ(current["events"], baseline["events"]) << "the baseline " << path << " was recorded for a different trace";
+    EXPECT_LE(current["unreported"], baseline["unreported"]) << "more events than in the baseline " << path << " sent no report";
+    for (const char* name : {"p50", "p90", "p99", "max"}) {
+        EXPECT_LE(current[name], baseline[name] + tolerance) << name << " latency regressed against the baseline " << path;
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "report.h"
+}
+
+/**
+ * @brief A matrix event of a recorded typing trace, at `time` ms from the
+ * start of the recording.
+ */
+struct TraceEvent {
+    uint32_t time;
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+/**
+ * @brief Parses a typing trace, one event per line.
+ *
+ * Two line formats are understood:
+ *
+ * - `<time> <col> <row> <d|u>`, with the time in ms, as written by hand or by
+ *   a tool converting a recording.
+ * - The `EVENT: RRCCd(time)` lines printed by the firmware when action
+ *   debugging is on, so a log captured with `qmk console` from a real board
+ *   can be replayed as is. Their 16-bit timestamps are unwrapped, which
+ *   assumes no two events are more than a minute apart.
+ *
+ * Empty lines, `#` comments and any other lines of a console log are skipped.
+ * The events are returned relative to the first one.
+ */
+std::vector<TraceEvent> parse_trace(std::istream& input);
+
+/**
+ * @brief Reads a trace with `parse_trace` from `path`, relative to the root
+ * of the repository, where the tests are run from.
+ */
+std::vector<TraceEvent> load_trace(const std::string& path);
+
+/**
+ * @brief Generates a trace of `keystrokes` presses and releases of `keys`,
+ * with rolls between them, for replays longer than a recording. The same seed
+ * always produces the same trace.
+ */
+std::vector<TraceEvent> generate_trace(const std::vector<KeymapKey>& keys, uint32_t keystrokes, uint32_t seed = 1);
+
+/**
+ * @brief A HID report sent during a replay, and when it was sent.
+ */
+struct TraceReport {
+    enum Type { KEYBOARD, NKRO, MOUSE, EXTRA };
+
+    uint32_t          time;
+    Type              type;
+    report_keyboard_t keyboard;
+};
+
+/**
+ * @brief Distribution of the time from each event of a trace to the first
+ * report sent at or after it, in ms.
+ *
+ * Events that aren't followed by a report within the latency window of the
+ * replay, such as presses of a layer key, are counted as unreported instead.
+ */
+struct TraceLatency {
+    uint32_t events;
+    uint32_t unreported;
+    uint32_t p50;
+    uint32_t p90;
+    uint32_t p99;
+    uint32_t max;
+    double   mean;
+};
+
+/**
+ * @brief Test fixture that replays recorded typing traces through the key
+ * processing pipeline with the mocked timer.
+ *
+ * The reports are recorded by a host driver of the fixture rather than the
+ * gmock `TestDriver`, so a trace of tens of thousands of keystrokes needs no
+ * expectations. All keys of the trace must be mapped with `add_key` first.
+ */
+class TraceReplayFixture : public TestFixture {
+   public:
+    /**
+     * @brief Replays `trace` and returns the latency of its events. Reports
+     * more than `max_latency` ms after an event aren't attributed to it.
+     */
+    TraceLatency replay(const std::vector<TraceEvent>& trace, uint32_t max_latency = 1000);
+
+    /**
+     * @brief Fails if `latency` is worse than the baseline stored at `path`,
+     * by more than `tolerance` ms for the percentiles and the maximum.
+     *
+     * Run the test with `QMK_TRACE_UPDATE_BASELINE=1` in the environment to
+     * write the current latency as the new baseline instead.
+     */
+    void expect_latency_baseline(const TraceLatency& latency, const std::string& path, uint32_t tolerance = 0);
+
+    /** The reports sent during the last replay. */
+    std::vector<TraceReport> reports;
+};
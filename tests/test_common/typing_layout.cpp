@@ -0,0 +1,25 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "typing_layout.hpp"
+#include <algorithm>
+#include "keycode.h"
+
+std::vector<KeymapKey> typing_layout(std::initializer_list<KeymapKey> overrides) {
+    static const uint16_t letters[] = {KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P, KC_A, KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L, KC_SCLN, KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH};
+
+    std::vector<KeymapKey> keys;
+    for (uint8_t i = 0; i < 30; i++) {
+        uint8_t col = i % 10, row = i / 10;
+        auto    key = std::find_if(overrides.begin(), overrides.end(), [&](const KeymapKey& key) { return key.position.col == col && key.position.row == row; });
+        keys.push_back(key != overrides.end() ? *key : KeymapKey(0, col, row, letters[i]));
+    }
+    return keys;
+}
+
+uint32_t typing_random(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
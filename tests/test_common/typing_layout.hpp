@@ -0,0 +1,23 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <initializer_list>
+#include <vector>
+#include "test_keymap_key.hpp"
+
+/**
+ * @brief The letter keys of a QWERTY layout, as the first ten columns of the
+ * first three rows of layer 0, shared by the benchmarks and the trace replays.
+ *
+ * Keys of `overrides` replace the letter at their position. The keys still
+ * have to be mapped with `add_key`.
+ */
+std::vector<KeymapKey> typing_layout(std::initializer_list<KeymapKey> overrides = {});
+
+/**
+ * @brief Steps the xorshift32 generator of the synthetic typing streams, so
+ * they don't depend on the host's `rand()`. `state` must not be 0.
+ */
+uint32_t typing_random(uint32_t& state);
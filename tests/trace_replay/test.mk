@@ -0,0 +1,4 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SRC += tests/test_common/trace_replay.cpp tests/test_common/typing_layout.cpp
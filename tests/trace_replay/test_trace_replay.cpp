@@ -0,0 +1,98 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <sstream>
+#include "keycode.h"
+#include "quantum.h"
+#include "test_common.h"
+#include "trace_replay.hpp"
+#include "typing_layout.hpp"
+
+class TraceReplay : public TraceReplayFixture {
+   protected:
+    // The layout typing.trace was recorded on, with `overrides` replacing
+    // some of its letters
+    std::vector<KeymapKey> map_layout(std::initializer_list<KeymapKey> overrides = {}) {
+        std::vector<KeymapKey> keys = typing_layout(overrides);
+        for (auto& key : keys) {
+            add_key(key);
+        }
+        return keys;
+    }
+};
+
+TEST_F(TraceReplay, parses_console_log) {
+    std::istringstream log(
+        "Listening for devices...\n"
+        "keyboard:1: ---- action_exec: start -----\n"
+        "keyboard:1: EVENT: 0102d(65530)\n"
+        "keyboard:1: ACTION: ACT_LMODS[anim=0 mods=00 key=04] layer_state: 00000001(0) default_layer_state: 00000001(0)\n"
+        "keyboard:1: EVENT: 0102u(84)\n"
+        "keyboard:1: EVENT: 0009d(100)\n");
+
+    auto trace = parse_trace(log);
+
+    ASSERT_EQ(trace.size(), 3);
+    EXPECT_EQ(trace[0].time, 0);
+    EXPECT_EQ(trace[0].col, 2);
+    EXPECT_EQ(trace[0].row, 1);
+    EXPECT_TRUE(trace[0].pressed);
+    EXPECT_EQ(trace[1].time, 90);
+    EXPECT_FALSE(trace[1].pressed);
+    EXPECT_EQ(trace[2].time, 106);
+    EXPECT_EQ(trace[2].col, 9);
+    EXPECT_EQ(trace[2].row, 0);
+}
+
+TEST_F(TraceReplay, plain_typing) {
+    map_layout();
+
+    auto latency = replay(load_trace("tests/trace_replay/typing.trace"));
+
+    EXPECT_EQ(latency.unreported, 0);
+    expect_latency_baseline(latency, "tests/trace_replay/plain_typing.baseline");
+}
+
+TEST_F(TraceReplay, home_row_mods) {
+    map_layout({
+        KeymapKey(0, 0, 1, LGUI_T(KC_A)),
+        KeymapKey(0, 1, 1, LALT_T(KC_S)),
+        KeymapKey(0, 2, 1, LCTL_T(KC_D)),
+        KeymapKey(0, 3, 1, LSFT_T(KC_F)),
+        KeymapKey(0, 6, 1, RSFT_T(KC_J)),
+        KeymapKey(0, 7, 1, RCTL_T(KC_K)),
+        KeymapKey(0, 8, 1, RALT_T(KC_L)),
+        KeymapKey(0, 9, 1, RGUI_T(KC_SCLN)),
+    });
+
+    auto latency = replay(load_trace("tests/trace_replay/typing.trace"));
+
+    expect_latency_baseline(latency, "tests/trace_replay/home_row_mods.baseline");
+}
+
+TEST_F(TraceReplay, long_plain_typing) {
+    auto keys = map_layout();
+
+    auto latency = replay(generate_trace(keys, 20000));
+
+    EXPECT_EQ(latency.events, 40000);
+    EXPECT_EQ(latency.unreported, 0);
+    EXPECT_EQ(latency.max, 0);
+}
+
+TEST_F(TraceReplay, long_home_row_mods) {
+    auto keys = map_layout({
+        KeymapKey(0, 0, 1, LGUI_T(KC_A)),
+        KeymapKey(0, 1, 1, LALT_T(KC_S)),
+        KeymapKey(0, 2, 1, LCTL_T(KC_D)),
+        KeymapKey(0, 3, 1, LSFT_T(KC_F)),
+        KeymapKey(0, 6, 1, RSFT_T(KC_J)),
+        KeymapKey(0, 7, 1, RCTL_T(KC_K)),
+        KeymapKey(0, 8, 1, RALT_T(KC_L)),
+        KeymapKey(0, 9, 1, RGUI_T(KC_SCLN)),
+    });
+
+    auto latency = replay(generate_trace(keys, 20000));
+
+    expect_latency_baseline(latency, "tests/trace_replay/long_home_row_mods.baseline");
+}
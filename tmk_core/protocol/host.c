@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "action_util.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -110,6 +111,9 @@ void host_nkro_send(report_nkro_t *report) {
 }
 
 void host_mouse_send(report_mouse_t *report) {
+    // a keyboard report held back in a batch was made first, so it goes first
+    keyboard_report_batch_send();
+
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_mouse(report);
@@ -132,6 +136,7 @@ void host_mouse_send(report_mouse_t *report) {
 void host_system_send(uint16_t usage) {
     if (usage == last_system_usage) return;
     last_system_usage = usage;
+    keyboard_report_batch_send();
 
     if (!driver) return;
 
@@ -145,6 +150,7 @@ void host_system_send(uint16_t usage) {
 void host_consumer_send(uint16_t usage) {
     if (usage == last_consumer_usage) return;
     last_consumer_usage = usage;
+    keyboard_report_batch_send();
 
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
@@ -165,6 +171,7 @@ void host_consumer_send(uint16_t usage) {
 #ifdef JOYSTICK_ENABLE
 void host_joystick_send(joystick_t *joystick) {
     if (!driver) return;
+    keyboard_report_batch_send();
 
     report_joystick_t report = {
 #    ifdef JOYSTICK_SHARED_EP
@@ -219,6 +226,8 @@ __attribute__((weak)) void send_joystick(report_joystick_t *report) {}
 
 #ifdef DIGITIZER_ENABLE
 void host_digitizer_send(digitizer_t *digitizer) {
+    keyboard_report_batch_send();
+
     report_digitizer_t report = {
 #    ifdef DIGITIZER_SHARED_EP
         .report_id = REPORT_ID_DIGITIZER,
@@ -238,6 +247,8 @@ __attribute__((weak)) void send_digitizer(report_digitizer_t *report) {}
 
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
 void host_programmable_button_send(uint32_t data) {
+    keyboard_report_batch_send();
+
     report_programmable_button_t report = {
         .report_id = REPORT_ID_PROGRAMMABLE_BUTTON,
         .usage     = data,